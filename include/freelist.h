@@ -1,12 +1,64 @@
 #ifndef FL_FREELIST_H
 #define FL_FREELIST_H
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace fl {
 
     // Private Implementation Classes
+
+    // The construct end, destroy end and slots of a pool are each given their own cache line, so a producer and a
+    // consumer on different cores don't false share
+#if defined(__cpp_lib_hardware_interference_size)
+    // GCC warns that the value may differ between the translation units of a program tuned for different CPUs
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+    constexpr size_t c_cacheLineSize = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+    constexpr size_t c_cacheLineSize = 64;
+#endif
     class FreeListNode {
     public:
         void setNext(FreeListNode *const node) noexcept {
@@ -32,63 +84,434 @@ namespace fl {
     template<typename T>
     struct FreeListAlloc {
         template<typename... Args>
-        explicit FreeListAlloc(void *const alloc, Args... args)
+        explicit FreeListAlloc(void *const alloc, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
                 : m_allocator(alloc), m_data(std::forward<Args>(args)...) {
         }
 
+        // Recover the slot from a pointer to its object
+        static FreeListAlloc* fromData(T *const p) noexcept {
+            return reinterpret_cast< FreeListAlloc* >(reinterpret_cast<void **>(p) - 1);
+        }
+
         const void *m_allocator;
         T m_data;
     };
 
+    // Run construct, which placement constructs a T from Args, running repair before rethrowing if it throws. The
+    // try/catch is only emitted when the constructor may throw
+    template<typename T, typename... Args, typename Construct, typename Repair>
+    auto constructOrRepair(Construct&& construct, Repair&& repair) -> decltype(construct()) {
+        if constexpr (std::is_nothrow_constructible<T, Args...>::value) {
+            return construct();
+        }
+        else {
+            try {
+                return construct();
+            }
+            catch (...) {
+                repair();
+                throw;
+            }
+        }
+    }
+
+    // Run the destructor of T, which is skipped entirely for trivially destructible types
+    template<typename T>
+    void destroyAt(T *const p) noexcept {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            p->~T();
+        }
+    }
+
     // Public Interface Classes
+
+    // A point in time view of a pool's stats. Counters are read one after another while the pool may be in use, so
+    // the view is only approximately consistent
+    struct FreeListStatsSnapshot {
+        uint64_t                        m_constructs = 0;
+        uint64_t                        m_destroys = 0;
+        // Construct calls, single or batch, that came up short because the pool was exhausted
+        uint64_t                        m_failures = 0;
+        uint64_t                        m_casRetries = 0;
+        uint64_t                        m_live = 0;
+        uint64_t                        m_highWatermark = 0;
+    };
+
+    // Stats policy that keeps nothing. Every hook is an empty inline function, so the counting compiles away
+    class FreeListNoStats {
+    public:
+        static constexpr bool c_enabled = false;
+
+        void constructed(const size_t = 1) noexcept {
+        }
+
+        void destroyed(const size_t = 1) noexcept {
+        }
+
+        void failed() noexcept {
+        }
+
+        void casRetried() noexcept {
+        }
+
+        FreeListStatsSnapshot snapshot() const noexcept {
+            return FreeListStatsSnapshot();
+        }
+    };
+
+    // Stats policy that counts a pool's activity. Counters are sharded, with each thread assigned a shard on its own
+    // cache line, so updating them doesn't serialise threads the pool itself doesn't. The high watermark is sampled
+    // whenever a shard passes a multiple of c_watermarkInterval constructs, on exhaustion and on every snapshot, so
+    // may miss shorter spikes that don't exhaust the pool
+    class FreeListStats {
+    public:
+        static constexpr bool c_enabled = true;
+        static constexpr size_t c_shards = 16;
+        static constexpr uint64_t c_watermarkInterval = 64;
+
+        FreeListStats() = default;
+        ~FreeListStats() = default;
+
+        void constructed(const size_t count = 1) noexcept {
+            auto constructs = local().m_constructs.fetch_add(count, std::memory_order_relaxed);
+            if ((constructs + count) / c_watermarkInterval != constructs / c_watermarkInterval) {
+                sampleWatermark(live());
+            }
+        }
+
+        void destroyed(const size_t count = 1) noexcept {
+            local().m_destroys.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        // Exhaustion is when the pool is at its fullest, so is always sampled
+        void failed() noexcept {
+            local().m_failures.fetch_add(1, std::memory_order_relaxed);
+            sampleWatermark(live());
+        }
+
+        void casRetried() noexcept {
+            local().m_casRetries.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        FreeListStatsSnapshot snapshot() const noexcept {
+            FreeListStatsSnapshot snapshot;
+            for (auto& shard : m_shards) {
+                snapshot.m_constructs += shard.m_constructs.load(std::memory_order_relaxed);
+                snapshot.m_destroys += shard.m_destroys.load(std::memory_order_relaxed);
+                snapshot.m_failures += shard.m_failures.load(std::memory_order_relaxed);
+                snapshot.m_casRetries += shard.m_casRetries.load(std::memory_order_relaxed);
+            }
+            // Destroys read after their constructs may briefly outnumber them
+            snapshot.m_live = snapshot.m_constructs > snapshot.m_destroys ? snapshot.m_constructs - snapshot.m_destroys : 0;
+            snapshot.m_highWatermark = sampleWatermark(snapshot.m_live);
+            return snapshot;
+        }
+
+    private:
+        FreeListStats(const FreeListStats &) = delete;
+        FreeListStats(FreeListStats &&) = delete;
+        FreeListStats &operator=(const FreeListStats &) = delete;
+        FreeListStats &operator=(FreeListStats &) = delete;
+
+        struct alignas(c_cacheLineSize) Shard {
+            std::atomic< uint64_t >     m_constructs{0};
+            std::atomic< uint64_t >     m_destroys{0};
+            std::atomic< uint64_t >     m_failures{0};
+            std::atomic< uint64_t >     m_casRetries{0};
+        };
+
+        // Threads are dealt shards in turn as they first count anything, whichever pool that's in
+        Shard& local() noexcept {
+            static std::atomic< size_t > s_nextShard(0);
+            thread_local size_t t_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % c_shards;
+            return m_shards[t_shard];
+        }
+
+        uint64_t live() const noexcept {
+            uint64_t constructs = 0;
+            uint64_t destroys = 0;
+            for (auto& shard : m_shards) {
+                constructs += shard.m_constructs.load(std::memory_order_relaxed);
+                destroys += shard.m_destroys.load(std::memory_order_relaxed);
+            }
+            return constructs > destroys ? constructs - destroys : 0;
+        }
+
+        // Raise the high watermark to live, returning the resulting watermark
+        uint64_t sampleWatermark(const uint64_t live) const noexcept {
+            auto watermark = m_highWatermark.load(std::memory_order_relaxed);
+            while (live > watermark &&
+                   !m_highWatermark.compare_exchange_weak(watermark, live, std::memory_order_relaxed)) {
+            }
+            return std::max(watermark, live);
+        }
+
+        Shard                           m_shards[c_shards];
+        alignas(c_cacheLineSize) mutable std::atomic< uint64_t >
+                                        m_highWatermark{0};
+    };
+
+    // Whether an allocator keeps stats, for code that reaches the allocator through a slot, so the counting compiles
+    // away for allocators without a stats policy, or with one that's disabled
+    template< typename Allocator, typename = void >
+    struct FreeListKeepsStats : std::false_type {
+    };
+
+    template< typename Allocator >
+    struct FreeListKeepsStats< Allocator, std::void_t< typename Allocator::StatsPolicy > >
+            : std::integral_constant< bool, Allocator::StatsPolicy::c_enabled > {
+    };
+
     template<typename T, typename Allocator>
     class FreeListDeleter {
     public:
         void operator()(T *p) const noexcept {
-            auto cursor = reinterpret_cast<void **>(p) - 1;
-            auto alloc = reinterpret_cast< Allocator * >(*cursor);
-            alloc->destroy(reinterpret_cast< FreeListAlloc<T> * >(cursor));
+            auto node = FreeListAlloc<T>::fromData(p);
+            auto alloc = reinterpret_cast< Allocator * >(const_cast< void* >(node->m_allocator));
+            alloc->destroy(node);
+        }
+    };
+
+    // A FreeListDeleter compatible collector, which defers destroys and returns them to their pools in batches.
+    // Each batch runs the destructors and links the slots privately, then publishes every run of slots from the
+    // same pool with a single append. Batches are flushed when Capacity objects are pending, by flush, and on
+    // destruction. The collector itself is single-threaded
+    template< typename T, typename Allocator, size_t Capacity = 64 >
+    class FreeListBatchDeleter {
+    public:
+        FreeListBatchDeleter() = default;
+
+        ~FreeListBatchDeleter() {
+            flush();
+        }
+
+        void operator()(T *p) noexcept {
+            m_pending[m_count++] = p;
+            if (m_count == Capacity) {
+                flush();
+            }
+        }
+
+        void add(std::unique_ptr< T, FreeListDeleter< T, Allocator > >&& p) noexcept {
+            if (p) {
+                (*this)(p.release());
+            }
+        }
+
+        void flush() noexcept {
+            const void* runAllocator = nullptr;
+            FreeListNode* runFirst = nullptr;
+            FreeListNode* runLast = nullptr;
+            size_t runCount = 0;
+
+            for (size_t i = 0 ; i < m_count ; ++i) {
+                auto node = FreeListAlloc<T>::fromData(m_pending[i]);
+                auto allocator = node->m_allocator;
+                destroyAt(&node->m_data);
+
+                auto freeNode = reinterpret_cast< FreeListNode* >(node);
+                if (runLast && allocator == runAllocator) {
+                    runLast->setNext(freeNode);
+                }
+                else {
+                    release(runAllocator, runFirst, runLast, runCount);
+                    runAllocator = allocator;
+                    runFirst = freeNode;
+                    runCount = 0;
+                }
+                runLast = freeNode;
+                ++runCount;
+            }
+            release(runAllocator, runFirst, runLast, runCount);
+            m_count = 0;
+        }
+
+    private:
+        FreeListBatchDeleter(const FreeListBatchDeleter &) = delete;
+        FreeListBatchDeleter(FreeListBatchDeleter &&) = delete;
+        FreeListBatchDeleter &operator=(const FreeListBatchDeleter &) = delete;
+        FreeListBatchDeleter &operator=(FreeListBatchDeleter &) = delete;
+
+        static void release(const void* const allocator, FreeListNode* const first, FreeListNode* const last,
+                            const size_t count) noexcept {
+            if (last) {
+                auto alloc = reinterpret_cast< Allocator * >(const_cast< void* >(allocator));
+                if constexpr (FreeListKeepsStats< Allocator >::value) {
+                    alloc->stats().destroyed(count);
+                }
+                alloc->release(first, last);
+            }
         }
+
+        T*                              m_pending[Capacity];
+        size_t                          m_count = 0;
     };
 
+    // The head is a single word holding the node pointer in its low 48 bits and a generation tag in its high 16 bits.
+    // Every update to the head bumps the tag, so a pop whose head was popped, recycled and pushed back in between
+    // sees a different word and retries, rather than installing the stale next it read (ABA). The tag only wraps after
+    // 65536 head updates within a single pop. User space pointers fit in 48 bits on x86-64 and AArch64 Linux, unless
+    // 5-level paging is on and memory was mapped at a hint above that, so pools refuse memory that doesn't fit
     template<typename T, typename Allocator>
     class FreeListMTConstruct {
     public:
         using Deleter = FreeListDeleter<T, Allocator>;
         using ptr = std::unique_ptr<T, Deleter>;
 
+        static constexpr bool c_multiThreaded = true;
+
         FreeListMTConstruct() = default;
         ~FreeListMTConstruct() = default;
 
         void setHead(FreeListNode* const node) noexcept {
-            m_head.store(node, std::memory_order_release);
+            m_head.store(tagged(node, m_head.load(std::memory_order_relaxed)), std::memory_order_release);
         }
 
-        // Multi-threaded Construct - Lock free
-        template<typename... Args>
-        ptr construct(Args... args) {
+        // Hand out the never-used slots from first up to last by bumping a pointer, before any are linked
+        void setBump(FreeListAlloc<T>* const first, FreeListAlloc<T>* const last) noexcept {
+            m_bumpEnd = last;
+            m_bump.store(first, std::memory_order_release);
+        }
+
+        // Whether memory ending at end can be tagged, which holds for all of it as addresses only grow towards end
+        static bool addressable(const void* const end) noexcept {
+            return (reinterpret_cast< uint64_t >(end) & ~c_pointerMask) == 0;
+        }
+
+        FreeListNode* head() const noexcept {
+            return pointer(m_head.load(std::memory_order_acquire));
+        }
+
+        bool exhausted() const noexcept {
+            return pointer(m_head.load(std::memory_order_acquire))->next() == nullptr &&
+                   m_bump.load(std::memory_order_relaxed) == m_bumpEnd;
+        }
+
+        // Multi-threaded prepend of a pre-linked chain - Lock free
+        void prepend(FreeListNode* const first, FreeListNode* const last) noexcept {
             auto head = m_head.load(std::memory_order_acquire);
-            FreeListNode *next = nullptr;
-            do {
-                next = head->next();
-            } while (next &&
-                     !m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire));
+            last->setNext(pointer(head));
+            while (!m_head.compare_exchange_weak(head, tagged(first, head), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                retried();
+                last->setNext(pointer(head));
+            }
+        }
 
-            if (next) {
-                try {
-                    auto rtnObj = new(reinterpret_cast< void * >(head)) FreeListAlloc<T>(this,
-                                                                                         std::forward<Args>(args)...);
-                    return ptr(&rtnObj->m_data);
+        // Multi-threaded swap of the head node - Lock free
+        FreeListNode* exchangeHead(FreeListNode* const node) noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            while (!m_head.compare_exchange_weak(head, tagged(node, head), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                retried();
+            }
+            return pointer(head);
+        }
+
+        // Multi-threaded conditional swap of the head node, which succeeds whenever the head is expected, whatever its
+        // tag - Lock free
+        bool compareExchangeHead(FreeListNode* const expected, FreeListNode* const node) noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            while (pointer(head) == expected) {
+                if (m_head.compare_exchange_weak(head, tagged(node, head), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return true;
+                }
+                retried();
+            }
+            return false;
+        }
+
+        // Multi-threaded pop of a single free node, or nullptr if only the sentinel remains - Lock free
+        FreeListNode* pop() noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            auto next = pointer(head)->next();
+            while (next &&
+                   !m_head.compare_exchange_weak(head, tagged(next, head), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                retried();
+                next = pointer(head)->next();
+            }
+
+            return next ? pointer(head) : nullptr;
+        }
+
+        // Multi-threaded claim of up to count never-used slots, starting at first - Lock free. Returns the number of
+        // slots claimed, which may be 0 once the bump range is used up
+        size_t bump(const size_t count, FreeListAlloc<T>*& first) noexcept {
+            auto slot = m_bump.load(std::memory_order_relaxed);
+            while (true) {
+                auto claimed = std::min(count, static_cast< size_t >(m_bumpEnd - slot));
+                if (claimed == 0) {
+                    return 0;
+                }
+                if (m_bump.compare_exchange_weak(slot, slot + claimed, std::memory_order_relaxed)) {
+                    first = slot;
+                    return claimed;
+                }
+                retried();
+            }
+        }
+
+        // Multi-threaded pop of a single free node, falling back to a never-used slot, or nullptr if neither
+        // remains - Lock free
+        FreeListNode* acquire() noexcept {
+            if (auto node = pop()) {
+                return node;
+            }
+
+            FreeListAlloc<T>* slot = nullptr;
+            return bump(1, slot) ? reinterpret_cast< FreeListNode* >(slot) : nullptr;
+        }
+
+        // Multi-threaded pop of up to count free nodes as a single chain, from first to last, with one compare
+        // exchange - Lock free. Returns the number of nodes popped, which may be 0 if only the sentinel remains.
+        // The walk only steps onto a link while the head word is unchanged, as otherwise the node it was read from may
+        // have been popped and its link overwritten by the slot's allocator
+        size_t acquire(const size_t count, FreeListNode*& first, FreeListNode*& last) noexcept {
+            if (count == 0) {
+                return 0;
+            }
+
+            auto head = m_head.load(std::memory_order_acquire);
+            while (true) {
+                auto node = pointer(head);
+                auto current = head;
+                size_t acquired = 0;
+                for (auto next = node->next() ; next ; next = node->next()) {
+                    current = m_head.load(std::memory_order_acquire);
+                    if (current != head) {
+                        break;
+                    }
+                    last = node;
+                    node = next;
+                    if (++acquired == count) {
+                        break;
+                    }
                 }
-                catch (...) {
-                    // A constructor throw. We need to repair head and put it back in the list
-                    do {
-                        head->setNext(next);
-                    } while (!m_head.compare_exchange_weak(next, head, std::memory_order_acq_rel,
-                                                             std::memory_order_acquire));
 
-                    throw;
+                if (current != head) {
+                    head = current;
+                }
+                else if (acquired == 0) {
+                    return bumpChain(count, first, last);
                 }
+                else if (m_head.compare_exchange_weak(head, tagged(node, head), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    first = pointer(head);
+                    return acquired;
+                }
+                retried();
+            }
+        }
+
+        // Multi-threaded Construct - Lock free
+        // Arguments are only consumed if construction takes place, so a nullptr return leaves them untouched
+        template<typename... Args>
+        ptr construct(Args&&... args) {
+            auto head = acquire();
+
+            if (head) {
+                auto rtnObj = constructOrRepair<T, Args&&...>(
+                        [&]() { return new(reinterpret_cast< void * >(head)) FreeListAlloc<T>(this, std::forward<Args>(args)...); },
+                        // A constructor throw. We need to put head back in the list
+                        [&]() { prepend(head, head); });
+                return ptr(&rtnObj->m_data);
             }
             else {
                 return nullptr;
@@ -101,7 +524,46 @@ namespace fl {
         FreeListMTConstruct &operator=(const FreeListMTConstruct &) = delete;
         FreeListMTConstruct &operator=(FreeListMTConstruct &) = delete;
 
-        std::atomic< FreeListNode* >    m_head;
+        // Claim up to count never-used slots, and link them into a chain from first to last
+        size_t bumpChain(const size_t count, FreeListNode*& first, FreeListNode*& last) noexcept {
+            FreeListAlloc<T>* slot = nullptr;
+            auto claimed = bump(count, slot);
+            for (size_t i = 0 ; i + 1 < claimed ; ++i) {
+                reinterpret_cast< FreeListNode* >(&slot[i])->setNext(reinterpret_cast< FreeListNode* >(&slot[i + 1]));
+            }
+            if (claimed) {
+                first = reinterpret_cast< FreeListNode* >(&slot[0]);
+                last = reinterpret_cast< FreeListNode* >(&slot[claimed - 1]);
+            }
+            return claimed;
+        }
+
+        // Count a lost compare exchange with the allocator's stats policy. The allocator is found from this, which
+        // relies on the construct policy being at offset 0 of the allocator, as FreeListBase checks
+        void retried() noexcept {
+            if constexpr (FreeListKeepsStats< Allocator >::value) {
+                reinterpret_cast< Allocator* >(this)->stats().casRetried();
+            }
+        }
+
+        static_assert(sizeof(FreeListNode*) == sizeof(uint64_t), "Tagged head requires 64-bit pointers");
+
+        static constexpr unsigned c_tagShift = 48;
+        static constexpr uint64_t c_pointerMask = (uint64_t(1) << c_tagShift) - 1;
+
+        static FreeListNode* pointer(const uint64_t word) noexcept {
+            return reinterpret_cast< FreeListNode* >(word & c_pointerMask);
+        }
+
+        // node, tagged with the generation following that of word
+        static uint64_t tagged(FreeListNode* const node, const uint64_t word) noexcept {
+            return reinterpret_cast< uint64_t >(node) | ((word & ~c_pointerMask) + (uint64_t(1) << c_tagShift));
+        }
+
+        std::atomic< uint64_t >         m_head{0};
+        std::atomic< FreeListAlloc<T>* >
+                                        m_bump{nullptr};
+        FreeListAlloc<T>*               m_bumpEnd = nullptr;
     };
 
     template<typename T, typename Allocator>
@@ -110,6 +572,8 @@ namespace fl {
         using Deleter = FreeListDeleter<T, Allocator>;
         using ptr = std::unique_ptr<T, Deleter>;
 
+        static constexpr bool c_multiThreaded = false;
+
         FreeListSTConstruct() = default;
         ~FreeListSTConstruct() = default;
 
@@ -117,24 +581,118 @@ namespace fl {
             m_head = node;
         }
 
-        // Single-threaded Construct - Wait free
-        template<typename... Args>
-        ptr construct(Args... args) {
-            auto next = m_head->next();
+        // Hand out the never-used slots from first up to last by bumping a pointer, before any are linked
+        void setBump(FreeListAlloc<T>* const first, FreeListAlloc<T>* const last) noexcept {
+            m_bump = first;
+            m_bumpEnd = last;
+        }
+
+        // The head is a plain pointer, so any memory will do
+        static bool addressable(const void* const) noexcept {
+            return true;
+        }
+
+        FreeListNode* head() const noexcept {
+            return m_head;
+        }
+
+        bool exhausted() const noexcept {
+            return m_head->next() == nullptr && m_bump == m_bumpEnd;
+        }
+
+        // Single-threaded prepend of a pre-linked chain - Wait free
+        void prepend(FreeListNode* const first, FreeListNode* const last) noexcept {
+            last->setNext(m_head);
+            m_head = first;
+        }
+
+        // Single-threaded swap of the head node - Wait free
+        FreeListNode* exchangeHead(FreeListNode* const node) noexcept {
+            auto head = m_head;
+            m_head = node;
+            return head;
+        }
+
+        // Single-threaded conditional swap of the head node - Wait free
+        bool compareExchangeHead(FreeListNode* const expected, FreeListNode* const node) noexcept {
+            if (m_head != expected) {
+                return false;
+            }
+            m_head = node;
+            return true;
+        }
+
+        // Single-threaded pop of a single free node, or nullptr if only the sentinel remains - Wait free
+        FreeListNode* pop() noexcept {
+            auto head = m_head;
+            auto next = head->next();
 
             if (next) {
-                try {
-                    auto rtnObj = new(reinterpret_cast< void * >(m_head)) FreeListAlloc<T>(this,
-                                                                                           std::forward<Args>(args)...);
-                    m_head = next;
-                    return ptr(&rtnObj->m_data);
-                }
-                catch (...) {
-                    // A constructor throw. Repair head
-                    m_head->setNext(next);
-                    throw;
+                m_head = next;
+                return head;
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        // Single-threaded claim of up to count never-used slots, starting at first - Wait free. Returns the number
+        // of slots claimed, which may be 0 once the bump range is used up
+        size_t bump(const size_t count, FreeListAlloc<T>*& first) noexcept {
+            auto claimed = std::min(count, static_cast< size_t >(m_bumpEnd - m_bump));
+            first = m_bump;
+            m_bump += claimed;
+            return claimed;
+        }
+
+        // Single-threaded pop of a single free node, falling back to a never-used slot, or nullptr if neither
+        // remains - Wait free
+        FreeListNode* acquire() noexcept {
+            if (auto node = pop()) {
+                return node;
+            }
+
+            FreeListAlloc<T>* slot = nullptr;
+            return bump(1, slot) ? reinterpret_cast< FreeListNode* >(slot) : nullptr;
+        }
+
+        // Single-threaded pop of up to count free nodes as a single chain, from first to last, in one pass - Wait free
+        // Returns the number of nodes popped, which may be 0 if only the sentinel remains and the bump range is used up
+        size_t acquire(const size_t count, FreeListNode*& first, FreeListNode*& last) noexcept {
+            size_t acquired = 0;
+            auto node = m_head;
+            if (count != 0) {
+                for (auto next = node->next() ; next ; next = node->next()) {
+                    last = node;
+                    node = next;
+                    if (++acquired == count) {
+                        break;
+                    }
                 }
             }
+
+            if (acquired == 0) {
+                return bumpChain(count, first, last);
+            }
+
+            first = m_head;
+            m_head = node;
+            return acquired;
+        }
+
+        // Single-threaded Construct - Wait free
+        // Arguments are only consumed if construction takes place, so a nullptr return leaves them untouched
+        template<typename... Args>
+        ptr construct(Args&&... args) {
+            auto head = acquire();
+
+            if (head) {
+                auto rtnObj = constructOrRepair<T, Args&&...>(
+                        [&]() { return new(reinterpret_cast< void * >(head)) FreeListAlloc<T>(this, std::forward<Args>(args)...); },
+                        // A constructor throw. Put head back in the list
+                        [&]() { prepend(head, head); });
+                return ptr(&rtnObj->m_data);
+            }
             else {
                 return nullptr;
             }
@@ -146,12 +704,36 @@ namespace fl {
         FreeListSTConstruct &operator=(const FreeListSTConstruct &) = delete;
         FreeListSTConstruct &operator=(FreeListSTConstruct &) = delete;
 
+        // Claim up to count never-used slots, and link them into a chain from first to last
+        size_t bumpChain(const size_t count, FreeListNode*& first, FreeListNode*& last) noexcept {
+            FreeListAlloc<T>* slot = nullptr;
+            auto claimed = bump(count, slot);
+            for (size_t i = 0 ; i + 1 < claimed ; ++i) {
+                reinterpret_cast< FreeListNode* >(&slot[i])->setNext(reinterpret_cast< FreeListNode* >(&slot[i + 1]));
+            }
+            if (claimed) {
+                first = reinterpret_cast< FreeListNode* >(&slot[0]);
+                last = reinterpret_cast< FreeListNode* >(&slot[claimed - 1]);
+            }
+            return claimed;
+        }
+
         FreeListNode*                   m_head;
+        FreeListAlloc<T>*               m_bump = nullptr;
+        FreeListAlloc<T>*               m_bumpEnd = nullptr;
     };
 
+    // The order in which freed slots are handed out again. Fifo appends them at the tail, so a freed slot is reused
+    // after every other free slot, and the producer and consumer each own one end of the list. Lifo pushes them onto
+    // the head, so the most recently freed, and likely still cached, slot is reused first
+    enum class FreeListReuse { Fifo, Lifo };
+
     template < typename T >
     class FreeListMTDestroy {
     public:
+        static constexpr bool c_multiThreaded = true;
+        static constexpr FreeListReuse c_reuse = FreeListReuse::Fifo;
+
         FreeListMTDestroy() = default;
         ~FreeListMTDestroy() = default;
 
@@ -161,11 +743,16 @@ namespace fl {
 
         // Multi-threaded destroy - Wait free - assumes node is non-null
         void destroy(FreeListAlloc<T>* const node) noexcept {
-            node->m_data.~T();
+            destroyAt(&node->m_data);
             auto freeNode = reinterpret_cast< FreeListNode* >(node);
-            freeNode->setNext(nullptr);
-            auto prevNode = m_tail.exchange(freeNode, std::memory_order_acq_rel);
-            prevNode->setNext(freeNode);
+            append(freeNode, freeNode);
+        }
+
+        // Multi-threaded append of a pre-linked chain - Wait free
+        void append(FreeListNode* const first, FreeListNode* const last) noexcept {
+            last->setNext(nullptr);
+            auto prevNode = m_tail.exchange(last, std::memory_order_acq_rel);
+            prevNode->setNext(first);
         }
 
     protected:
@@ -181,6 +768,9 @@ namespace fl {
     template < typename T >
     class FreeListSTDestroy {
     public:
+        static constexpr bool c_multiThreaded = false;
+        static constexpr FreeListReuse c_reuse = FreeListReuse::Fifo;
+
         FreeListSTDestroy() = default;
         ~FreeListSTDestroy() = default;
 
@@ -190,11 +780,16 @@ namespace fl {
 
         // Single-threaded destroy - Wait free - assumes node is non-null
         void destroy(FreeListAlloc<T>* const node) noexcept {
-            node->m_data.~T();
+            destroyAt(&node->m_data);
             auto freeNode = reinterpret_cast< FreeListNode* >(node);
-            freeNode->setNext(nullptr);
-            m_tail->setNext(freeNode);
-            m_tail = freeNode;
+            append(freeNode, freeNode);
+        }
+
+        // Single-threaded append of a pre-linked chain - Wait free
+        void append(FreeListNode* const first, FreeListNode* const last) noexcept {
+            last->setNext(nullptr);
+            m_tail->setNext(first);
+            m_tail = last;
         }
 
     protected:
@@ -207,98 +802,2933 @@ namespace fl {
 
     };
 
-    template< typename T, template< typename, typename > class Construct, template < typename > class Destroy >
+    // Destroy policy for LIFO reuse. Freed slots are pushed onto the head through the construct policy, so destroys
+    // are exactly as thread safe as constructs, and the tail is never used
+    template < typename T >
+    class FreeListLIFODestroy {
+    public:
+        static constexpr bool c_multiThreaded = false;
+        static constexpr FreeListReuse c_reuse = FreeListReuse::Lifo;
+
+        FreeListLIFODestroy() = default;
+        ~FreeListLIFODestroy() = default;
+
+        void setTail(FreeListNode* const) noexcept {
+        }
+
+    protected:
+        FreeListLIFODestroy(const FreeListLIFODestroy &) = delete;
+        FreeListLIFODestroy(FreeListLIFODestroy &&) = delete;
+        FreeListLIFODestroy &operator=(const FreeListLIFODestroy &) = delete;
+        FreeListLIFODestroy &operator=(FreeListLIFODestroy &) = delete;
+    };
+
+    template< typename T, template< typename, typename > class Construct, template < typename > class Destroy,
+              typename Stats = FreeListNoStats >
     class FreeListBase {
     public:
         using Deleter = typename Construct< T, FreeListBase >::Deleter;
         using ptr = typename Construct< T, FreeListBase>::ptr;
+        template< size_t Capacity = 64 >
+        using BatchDeleter = FreeListBatchDeleter< T, FreeListBase, Capacity >;
+        using StatsPolicy = Stats;
+
+        using value_type = T;
+
+        static constexpr FreeListReuse c_reuse = Destroy< T >::c_reuse;
+        static constexpr bool c_multiThreadedConstruct = Construct< T, FreeListBase >::c_multiThreaded;
+        static constexpr bool c_multiThreadedDestroy =
+                c_reuse == FreeListReuse::Lifo ? c_multiThreadedConstruct : Destroy< T >::c_multiThreaded;
 
         template< typename... Args >
-        ptr construct(Args... args) {
-            return m_construct.construct(std::forward< Args >(args)...);
+        ptr construct(Args&&... args) {
+            auto rtnObj = tryConstruct(std::forward< Args >(args)...);
+            if (!rtnObj) {
+                m_stats.failed();
+            }
+            return rtnObj;
         }
 
         void destroy(FreeListAlloc<T>* const node) noexcept {
-            m_destroy.destroy(node);
+            m_stats.destroyed();
+            if constexpr (c_reuse == FreeListReuse::Lifo) {
+                destroyAt(&node->m_data);
+                auto freeNode = reinterpret_cast< FreeListNode* >(node);
+                m_construct.prepend(freeNode, freeNode);
+            }
+            else {
+                m_destroy.destroy(node);
+            }
         }
 
-    protected:
-        FreeListBase() = default;
-        ~FreeListBase() = default;
+        // Destroy every object in a range of ptrs, all from this pool, leaving the ptrs null. The slots are linked
+        // privately and returned to the list with a single append
+        template< typename It >
+        void destroyBatch(It first, const It last) noexcept {
+            FreeListNode* chainFirst = nullptr;
+            FreeListNode* chainLast = nullptr;
+            size_t destroyed = 0;
 
-        FreeListBase(const FreeListBase &) = delete;
-        FreeListBase(FreeListBase &&) = delete;
-        FreeListBase &operator=(const FreeListBase &) = delete;
-        FreeListBase &operator=(FreeListBase &) = delete;
+            for ( ; first != last ; ++first) {
+                if (auto obj = first->release()) {
+                    auto node = FreeListAlloc<T>::fromData(obj);
+                    destroyAt(&node->m_data);
 
-        void initFreeList(FreeListAlloc<T>* const array, const size_t size) noexcept {
-            m_construct.setHead(reinterpret_cast< FreeListNode* >(&array[0]));
-            m_destroy.setTail(reinterpret_cast< FreeListNode* >(&array[size]));
+                    auto freeNode = reinterpret_cast< FreeListNode* >(node);
+                    if (chainLast) {
+                        chainLast->setNext(freeNode);
+                    }
+                    else {
+                        chainFirst = freeNode;
+                    }
+                    chainLast = freeNode;
+                    ++destroyed;
+                }
+            }
 
-            // Point each array element toAlignmentNode the subsequent one
-            auto prevNode = reinterpret_cast< FreeListNode* >(&array[0]);
-            for (size_t i = 1 ; i <= size ; ++i) {
-                auto freeNode = reinterpret_cast< FreeListNode* >(&array[i]);
-                prevNode->setNext(freeNode);
-                prevNode = freeNode;
+            if (chainLast) {
+                m_stats.destroyed(destroyed);
+                release(chainFirst, chainLast);
             }
-            prevNode->setNext(nullptr);
         }
 
-    private:
-        Construct< T, FreeListBase >    m_construct;
-        Destroy< T >                    m_destroy;
-    };
+        // Construct up to count objects, each from the same arguments, moving a ptr to each into out. The slots are
+        // detached from the free list in a single operation, and any shortfall from the never-used slots in another.
+        // Returns the number constructed, which is less than count if the pool is exhausted. If a constructor throws,
+        // the objects already constructed remain in out, and the unused slots are returned to the list
+        template< typename OutputIt, typename... Args >
+        size_t constructBatch(OutputIt out, const size_t count, const Args&... args) {
+            auto constructed = constructInto(out, count, args...);
+            if (constructed < count) {
+                m_stats.failed();
+            }
+            return constructed;
+        }
 
-    // Always allocate to N + 1, so array has a sentinel if it's fully used
-    template< typename T, size_t N , template < typename, class > class Construct, template < typename > class Destroy >
-    class FreeListStatic : public FreeListBase< T, Construct, Destroy > {
-    public:
-        FreeListStatic() noexcept {
-            static_assert(sizeof(T) >= sizeof(FreeListNode), "Size of T must be greater or equal to FreeListNode");
-            static_assert(N >= 1, "N must be greater than 0");
+        // Node level interface, for adapters that construct into the slots themselves
+        // Pop a single free slot, or nullptr if the list is exhausted
+        FreeListNode* acquire() noexcept {
+            return m_construct.acquire();
+        }
 
-            FreeListBase< T, Construct, Destroy >::initFreeList(reinterpret_cast<AllocT*>(m_array), N);
+        // Pop up to count free slots as a single chain, from first to last, returning the number popped
+        size_t acquire(const size_t count, FreeListNode*& first, FreeListNode*& last) noexcept {
+            return m_construct.acquire(count, first, last);
         }
 
-        ~FreeListStatic() = default;
+        // Return a pre-linked chain of unconstructed slots to the list, at the end the reuse order takes them from
+        void release(FreeListNode* const first, FreeListNode* const last) noexcept {
+            if constexpr (c_reuse == FreeListReuse::Lifo) {
+                m_construct.prepend(first, last);
+            }
+            else {
+                m_destroy.append(first, last);
+            }
+        }
 
-    private:
-        FreeListStatic(const FreeListStatic &) = delete;
-        FreeListStatic(FreeListStatic &&) = delete;
-        FreeListStatic &operator=(const FreeListStatic &) = delete;
-        FreeListStatic &operator=(FreeListStatic &) = delete;
+        // The stats policy, whose snapshot may be taken while the pool is in use. Objects constructed through the node
+        // level interface aren't counted
+        Stats& stats() noexcept {
+            return m_stats;
+        }
+
+        const Stats& stats() const noexcept {
+            return m_stats;
+        }
+
+    protected:
+        // Slots and the construct policy find the pool from the construct policy's address, so it must be at offset 0
+        FreeListBase() noexcept {
+            static_assert(std::is_standard_layout< FreeListBase >::value, "FreeListBase must be standard layout");
+            static_assert(offsetof(FreeListBase, m_construct) == 0, "The construct policy must be at offset 0");
+        }
+
+        ~FreeListBase() = default;
+
+        FreeListBase(const FreeListBase &) = delete;
+        FreeListBase(FreeListBase &&) = delete;
+        FreeListBase &operator=(const FreeListBase &) = delete;
+        FreeListBase &operator=(FreeListBase &) = delete;
+
+        // Construct without counting a failure, for pools that may grow and try again
+        template< typename... Args >
+        ptr tryConstruct(Args&&... args) {
+            auto rtnObj = m_construct.construct(std::forward< Args >(args)...);
+            if (rtnObj) {
+                m_stats.constructed();
+            }
+            return rtnObj;
+        }
+
+        template< typename OutputIt, typename... Args >
+        size_t constructInto(OutputIt& out, const size_t count, const Args&... args) {
+            // Objects are counted once their ptr exists, as its deleter counts their destroy
+            size_t constructed = 0;
+            size_t counted = 0;
+            try {
+                constructed = constructChains(out, count, counted, args...);
+            }
+            catch (...) {
+                m_stats.constructed(counted);
+                throw;
+            }
+            m_stats.constructed(constructed);
+            return constructed;
+        }
+
+        template< typename OutputIt, typename... Args >
+        size_t constructChains(OutputIt& out, const size_t count, size_t& counted, const Args&... args) {
+            // Each pass detaches a single chain, from the free list while it has nodes, then from the never-used slots
+            size_t constructed = 0;
+            while (constructed < count) {
+                FreeListNode* first = nullptr;
+                FreeListNode* last = nullptr;
+                auto acquired = m_construct.acquire(count - constructed, first, last);
+                if (acquired == 0) {
+                    break;
+                }
+
+                auto node = first;
+                for (size_t i = 0 ; i < acquired ; ++i) {
+                    // Read before the slot is overwritten - the last node's link is into the list, so is not followed
+                    auto next = i + 1 < acquired ? node->next() : nullptr;
+                    auto rtnObj = constructOrRepair<T, const Args&...>(
+                            [&]() { return new(reinterpret_cast< void * >(node)) FreeListAlloc<T>(this, args...); },
+                            // A constructor throw. Put the unused slots back in the list
+                            [&]() {
+                                node->setNext(next);
+                                m_construct.prepend(node, last);
+                            });
+                    ++counted;
+                    try {
+                        *out = ptr(&rtnObj->m_data);
+                        ++out;
+                    }
+                    catch (...) {
+                        // The constructed slot has already been returned by its ptr, so put back the rest
+                        if (next) {
+                            m_construct.prepend(next, last);
+                        }
+                        throw;
+                    }
+                    node = next;
+                }
+                constructed += acquired;
+            }
+
+            return constructed;
+        }
+
+        // The last slot starts out as the sentinel, and the rest are handed out by the bump pointer until first
+        // destroyed, so nothing but the sentinel is touched up front
+        void initFreeList(FreeListAlloc<T>* const array, const size_t size) noexcept {
+            auto sentinel = reinterpret_cast< FreeListNode* >(&array[size]);
+            sentinel->setNext(nullptr);
+
+            m_construct.setHead(sentinel);
+            m_destroy.setTail(sentinel);
+            m_construct.setBump(&array[0], &array[size]);
+        }
+
+        // Link every slot up front, splitting the array across up to threads threads, leaving none to the bump pointer
+        void initFreeList(FreeListAlloc<T>* const array, const size_t size, const size_t threads) noexcept {
+            m_construct.setHead(reinterpret_cast< FreeListNode* >(&array[0]));
+            m_destroy.setTail(reinterpret_cast< FreeListNode* >(&array[size]));
+
+            linkFreeList(array, size + 1, threads)->setNext(nullptr);
+        }
+
+        // Chain a further array of size slots onto the construct end of the free list
+        void extendFreeList(FreeListAlloc<T>* const array, const size_t size, const size_t threads = 1) noexcept {
+            auto last = linkFreeList(array, size, threads);
+            m_construct.prepend(reinterpret_cast< FreeListNode* >(&array[0]), last);
+        }
+
+        // Whether the construct policy can hold memory ending at end in its head
+        static bool addressable(const void* const end) noexcept {
+            return Construct< T, FreeListBase >::addressable(end);
+        }
+
+        bool exhausted() const noexcept {
+            return m_construct.exhausted();
+        }
+
+        // Whether filterFreeList has the free list detached, so an exhausted list may only be waiting to be reattached
+        bool filtering() const noexcept {
+            return m_construct.head() == reinterpret_cast< const FreeListNode* >(&m_marker);
+        }
+
+        // Remove nodes from the free list without blocking concurrent destroys. A marker node with no successor is
+        // swapped in as the head, which detaches every free node from the construct end. Each detached node that has
+        // a successor is stable, so is passed to visit, then to drop, which returns true for those that are not to be
+        // reattached. The last detached node is left in place as destroy may be appending to it. Constructs see the
+        // list as exhausted until it is reattached, so this must be serialised against growth, which should wait out
+        // filtering() rather than grow. A construct still holding the detached head from before the swap fails its
+        // compare exchange, as the swap bumped the head's tag
+        template< typename Visit, typename Drop >
+        void filterFreeList(Visit&& visit, Drop&& drop) noexcept {
+            auto marker = reinterpret_cast< FreeListNode* >(&m_marker);
+            marker->setNext(nullptr);
+            auto first = m_construct.exchangeHead(marker);
+
+            for (auto node = first ; node->next() ; node = node->next()) {
+                visit(node);
+            }
+
+            // Relink the kept nodes privately, only publishing them through the head once complete
+            FreeListNode* keptFirst = nullptr;
+            FreeListNode* keptLast = nullptr;
+            auto keep = [&keptFirst, &keptLast](FreeListNode* const node) {
+                if (keptLast) {
+                    keptLast->setNext(node);
+                }
+                else {
+                    keptFirst = node;
+                }
+                keptLast = node;
+            };
+
+            auto node = first;
+            while (auto next = node->next()) {
+                if (!drop(node)) {
+                    keep(node);
+                }
+                node = next;
+            }
+
+            // A failed construct may have pushed its node back in front of the marker, so move any such node
+            // onto the kept chain until the marker is back at the head
+            while (true) {
+                if (keptLast) {
+                    keptLast->setNext(node);
+                }
+                if (m_construct.compareExchangeHead(marker, keptFirst ? keptFirst : node)) {
+                    break;
+                }
+                if (auto pushed = m_construct.pop()) {
+                    keep(pushed);
+                }
+            }
+        }
+
+    private:
+        // Point each array element to the subsequent one, returning the last element, whose next is left unset
+        static FreeListNode* linkFreeList(FreeListAlloc<T>* const array, const size_t size) noexcept {
+            auto prevNode = reinterpret_cast< FreeListNode* >(&array[0]);
+            for (size_t i = 1 ; i < size ; ++i) {
+                auto freeNode = reinterpret_cast< FreeListNode* >(&array[i]);
+                prevNode->setNext(freeNode);
+                prevNode = freeNode;
+            }
+            return prevNode;
+        }
+
+        // Link the array as above, split into a range per thread. Every slot's successor is known up front, so each
+        // range links straight into the next, leaving nothing to stitch together. A range whose thread can't be
+        // started is linked on the calling thread instead
+        static FreeListNode* linkFreeList(FreeListAlloc<T>* const array, const size_t size, const size_t threads) noexcept {
+            // Below this, starting a thread costs more than linking the range
+            constexpr size_t c_minRange = 65536;
+
+            auto ranges = std::min(threads, size / c_minRange);
+            if (ranges <= 1) {
+                return linkFreeList(array, size);
+            }
+
+            auto rangeSize = (size + ranges - 1) / ranges;
+            std::vector< std::thread > workers;
+            for (size_t range = 1 ; range < ranges ; ++range) {
+                auto first = range * rangeSize;
+                auto last = std::min(size, first + rangeSize);
+                try {
+                    workers.emplace_back(linkRange, array, first, last, size);
+                }
+                catch (...) {
+                    linkRange(array, first, last, size);
+                }
+            }
+            linkRange(array, 0, rangeSize, size);
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            return reinterpret_cast< FreeListNode* >(&array[size - 1]);
+        }
+
+        // Point each element from first up to last to the subsequent one, leaving the array's last element unset.
+        // Nothing reads the links until the list is published, so they're written with non-temporal stores where
+        // available, which don't pull every line into the cache, then fenced before the thread finishes
+        static void linkRange(FreeListAlloc<T>* const array, const size_t first, const size_t last, const size_t size) noexcept {
+            auto end = std::min(last, size - 1);
+            for (size_t i = first ; i < end ; ++i) {
+#if defined(__SSE2__) && defined(__x86_64__)
+                // The link is an atomic pointer, which has the representation of a plain one
+                _mm_stream_si64(reinterpret_cast< long long* >(&array[i]), reinterpret_cast< long long >(&array[i + 1]));
+#else
+                reinterpret_cast< FreeListNode* >(&array[i])->setNext(reinterpret_cast< FreeListNode* >(&array[i + 1]));
+#endif
+            }
+#if defined(__SSE2__) && defined(__x86_64__)
+            _mm_sfence();
+#endif
+        }
+
+        alignas(c_cacheLineSize) Construct< T, FreeListBase >   m_construct;
+        alignas(c_cacheLineSize) Destroy< T >                   m_destroy;
+        typename std::aligned_storage< sizeof(FreeListNode), alignof(FreeListNode) >::type
+                                                                m_marker;
+        Stats                                                   m_stats;
+    };
+
+    // Always allocate to N + 1, so array has a sentinel if it's fully used
+    template< typename T, size_t N , template < typename, class > class Construct, template < typename > class Destroy,
+              typename Stats = FreeListNoStats >
+    class FreeListStatic : public FreeListBase< T, Construct, Destroy, Stats > {
+    public:
+        FreeListStatic() noexcept {
+            static_assert(sizeof(T) >= sizeof(FreeListNode), "Size of T must be greater or equal to FreeListNode");
+            static_assert(N >= 1, "N must be greater than 0");
+
+            // The slots live inside the pool, so one placed beyond what the head can tag has nothing to fall back on
+            if (!FreeListBase< T, Construct, Destroy, Stats >::addressable(&m_array[N + 1])) {
+                std::terminate();
+            }
+            FreeListBase< T, Construct, Destroy, Stats >::initFreeList(reinterpret_cast<AllocT*>(m_array), N);
+        }
+
+        ~FreeListStatic() = default;
+
+    private:
+        FreeListStatic(const FreeListStatic &) = delete;
+        FreeListStatic(FreeListStatic &&) = delete;
+        FreeListStatic &operator=(const FreeListStatic &) = delete;
+        FreeListStatic &operator=(FreeListStatic &) = delete;
+
+        using AllocT = FreeListAlloc<T>;
+        alignas(c_cacheLineSize) typename std::aligned_storage< sizeof(AllocT), alignof(AllocT)>::type
+                                        m_array[N + 1];
+    };
+
+    // Describes how a FreeListDynamic grows once its free list is exhausted. Each growth allocates a further slab
+    // and chains it into the free list, until the total number of slots would exceed maxSize
+    class FreeListGrowth {
+    public:
+        enum class Mode { None, Fixed, Geometric };
+
+        // Never grow - construct returns nullptr on exhaustion
+        static FreeListGrowth none() noexcept {
+            return FreeListGrowth(Mode::None, 0, 0);
+        }
+
+        // Grow by slabSize slots each time
+        static FreeListGrowth fixed(const size_t slabSize, const size_t maxSize) noexcept {
+            return FreeListGrowth(Mode::Fixed, slabSize, maxSize);
+        }
+
+        // Multiply the total number of slots by factor each time
+        static FreeListGrowth geometric(const size_t factor, const size_t maxSize) noexcept {
+            return FreeListGrowth(Mode::Geometric, factor, maxSize);
+        }
+
+        Mode mode() const noexcept {
+            return m_mode;
+        }
+
+        // Size of the next slab given the current number of slots, or 0 if the pool may not grow any further
+        size_t slabSize(const size_t capacity) const noexcept {
+            if (m_mode == Mode::None || capacity >= m_maxSize) {
+                return 0;
+            }
+
+            size_t slabSize = m_step;
+            if (m_mode == Mode::Geometric) {
+                slabSize = m_step > 1 ? capacity * (m_step - 1) : 0;
+            }
+
+            return std::min(slabSize, m_maxSize - capacity);
+        }
+
+    private:
+        FreeListGrowth(const Mode mode, const size_t step, const size_t maxSize) noexcept
+                : m_mode(mode), m_step(step), m_maxSize(maxSize) {
+        }
+
+        Mode                            m_mode;
+        size_t                          m_step;
+        size_t                          m_maxSize;
+    };
+
+    // Describes where a FreeListDynamic gets the memory for its slabs. Huge pages cut the dTLB misses of walking a
+    // large, randomised free list. Each huge page option quietly falls back to the next when its pages aren't
+    // available, down to ordinary pages, and the mode actually used is returned by allocate.
+    // Latency-critical pools can also have every slab prefaulted, and optionally locked, as it's allocated, so no
+    // construct or destroy takes a page fault
+    class FreeListBacking {
+    public:
+        enum class Mode { Heap, TransparentHugePages, HugeTlb };
+
+        static constexpr size_t c_hugePageSize = 2 * 1024 * 1024;
+
+        // The C++ heap, through aligned_alloc
+        static FreeListBacking heap() noexcept {
+            return FreeListBacking(Mode::Heap);
+        }
+
+        // Anonymous memory on huge page boundaries, advised with MADV_HUGEPAGE
+        static FreeListBacking transparentHugePages() noexcept {
+            return FreeListBacking(Mode::TransparentHugePages);
+        }
+
+        // Reserved hugetlbfs pages through MAP_HUGETLB, falling back to transparent huge pages
+        static FreeListBacking hugeTlb() noexcept {
+            return FreeListBacking(Mode::HugeTlb);
+        }
+
+        // Pre-touch every page of each slab as it's allocated
+        FreeListBacking withPrefault() const noexcept {
+            auto backing = *this;
+            backing.m_prefault = true;
+            return backing;
+        }
+
+        // mlock every slab as it's allocated, which also faults its pages in, so they can't be swapped out either.
+        // A slab that can't be locked fails its allocation with std::system_error
+        FreeListBacking withLock() const noexcept {
+            auto backing = withPrefault();
+            backing.m_lock = true;
+            return backing;
+        }
+
+        Mode mode() const noexcept {
+            return m_mode;
+        }
+
+        bool prefault() const noexcept {
+            return m_prefault;
+        }
+
+        bool lock() const noexcept {
+            return m_lock;
+        }
+
+        // Allocate bytes aligned to alignment, which must be no greater than a huge page, setting used to the mode
+        // the memory came from, then prefault or lock it as requested. Throws std::bad_alloc if no memory is
+        // available at all, or std::system_error if it can't be locked
+        void* allocate(const size_t bytes, const size_t alignment, Mode& used) const {
+            auto p = map(bytes, alignment, used);
+
+            if (m_lock) {
+                if (mlock(p, bytes) != 0) {
+                    auto error = errno;
+                    release(p, bytes, used);
+                    throw std::system_error(error, std::generic_category(), "mlock");
+                }
+            }
+            else if (m_prefault) {
+                touch(p, bytes, used);
+            }
+
+            return p;
+        }
+
+        void deallocate(void* const p, const size_t bytes, const Mode used) const noexcept {
+            if (m_lock) {
+                munlock(p, bytes);
+            }
+            release(p, bytes, used);
+        }
+
+        // Write to every page of the range, so each is faulted in now rather than on first use
+        static void touch(void* const p, const size_t bytes, const Mode used) noexcept {
+            const auto pageSize = static_cast< uintptr_t >(FreeListBacking::pageSize(used));
+
+            auto begin = reinterpret_cast< uintptr_t >(p);
+            auto end = begin + bytes;
+            for (auto page = begin ; page < end ; page = (page + pageSize) & ~(pageSize - 1)) {
+                *reinterpret_cast< volatile char* >(page) = 0;
+            }
+        }
+
+        // The granularity pages can be released at from memory of the given mode
+        static size_t pageSize(const Mode used) noexcept {
+            static const auto systemPageSize = static_cast< size_t >(sysconf(_SC_PAGESIZE));
+            return used == Mode::HugeTlb ? c_hugePageSize : systemPageSize;
+        }
+
+    private:
+        explicit FreeListBacking(const Mode mode) noexcept
+                : m_mode(mode), m_prefault(false), m_lock(false) {
+        }
+
+        void* map(const size_t bytes, const size_t alignment, Mode& used) const {
+            if (m_mode == Mode::HugeTlb) {
+                auto p = mmap(nullptr, mappedBytes(bytes), PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) {
+                    used = Mode::HugeTlb;
+                    return p;
+                }
+            }
+
+            if (m_mode != Mode::Heap) {
+                // Over-map by a huge page, then unmap either side of the aligned range
+                auto length = mappedBytes(bytes);
+                auto p = mmap(nullptr, length + c_hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p != MAP_FAILED) {
+                    auto begin = reinterpret_cast< uintptr_t >(p);
+                    auto aligned = (begin + c_hugePageSize - 1) & ~(c_hugePageSize - 1);
+                    if (aligned > begin) {
+                        munmap(p, aligned - begin);
+                    }
+                    munmap(reinterpret_cast< void* >(aligned + length), begin + c_hugePageSize - aligned);
+
+                    // Advice is only a hint, so a kernel without transparent huge pages still leaves usable memory
+                    madvise(reinterpret_cast< void* >(aligned), length, MADV_HUGEPAGE);
+                    used = Mode::TransparentHugePages;
+                    return reinterpret_cast< void* >(aligned);
+                }
+            }
+
+            auto p = std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+            if (p == nullptr) {
+                throw std::bad_alloc();
+            }
+            used = Mode::Heap;
+            return p;
+        }
+
+        static void release(void* const p, const size_t bytes, const Mode used) noexcept {
+            if (used == Mode::Heap) {
+                std::free(p);
+            }
+            else {
+                munmap(p, mappedBytes(bytes));
+            }
+        }
+
+        static size_t mappedBytes(const size_t bytes) noexcept {
+            return (bytes + c_hugePageSize - 1) & ~(c_hugePageSize - 1);
+        }
+
+        Mode                            m_mode;
+        bool                            m_prefault;
+        bool                            m_lock;
+    };
+
+    // Describes how a FreeListDynamic prepares its initial slots. Lazy hands out never-used slots with a bump pointer,
+    // so construction is O(1) and pages are committed as they're used. Eager links every slot up front, touching
+    // every page, split across threads threads once the array is large enough to be worth it
+    class FreeListInit {
+    public:
+        enum class Mode { Lazy, Eager };
+
+        // Hand out never-used slots with a bump pointer
+        static FreeListInit lazy() noexcept {
+            return FreeListInit(Mode::Lazy, 1);
+        }
+
+        // Link every slot at construction, and every growth slab as it's added, on up to threads threads
+        static FreeListInit eager(const size_t threads = 1) noexcept {
+            return FreeListInit(Mode::Eager, std::max< size_t >(threads, 1));
+        }
+
+        Mode mode() const noexcept {
+            return m_mode;
+        }
+
+        size_t threads() const noexcept {
+            return m_threads;
+        }
+
+    private:
+        FreeListInit(const Mode mode, const size_t threads) noexcept
+                : m_mode(mode), m_threads(threads) {
+        }
+
+        Mode                            m_mode;
+        size_t                          m_threads;
+    };
+
+    // Always allocate to size + 1, so array has a sentinel if it's fully used
+    // Slabs added by growth need no sentinel of their own, as they're chained in front of the existing one
+    template< typename T, template < typename, class > class Construct, template < typename > class Destroy,
+              typename Stats = FreeListNoStats >
+    class FreeListDynamic : public FreeListBase< T, Construct, Destroy, Stats > {
+    public:
+        using ptr = typename FreeListBase< T, Construct, Destroy, Stats >::ptr;
+
+        explicit FreeListDynamic(const size_t size, const FreeListGrowth growth = FreeListGrowth::none(),
+                                 const FreeListBacking backing = FreeListBacking::heap(),
+                                 const FreeListInit init = FreeListInit::lazy())
+                : m_growth(growth), m_backing(backing), m_init(init), m_capacity(size), m_slabs(initialSlabs(size + 1)),
+                  m_initialBacking(m_slabs.front().m_backing) {
+            static_assert(sizeof(T) >= sizeof(FreeListNode), "Size of T must be greater or equal to FreeListNode");
+
+            if (m_init.mode() == FreeListInit::Mode::Eager) {
+                FreeListBase< T, Construct, Destroy, Stats >::initFreeList(m_slabs.front().m_array, size, m_init.threads());
+            }
+            else {
+                FreeListBase< T, Construct, Destroy, Stats >::initFreeList(m_slabs.front().m_array, size);
+            }
+        }
+
+        ~FreeListDynamic() {
+            for (auto& slab : m_slabs) {
+                m_backing.deallocate(slab.m_array, sizeof(AllocT) * slab.m_size, slab.m_backing);
+            }
+        }
+
+        // Construct, growing the free list if it's exhausted and the growth policy permits
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto rtnObj = FreeListBase< T, Construct, Destroy, Stats >::tryConstruct(std::forward< Args >(args)...);
+            // A nullptr return doesn't consume the arguments, so they're safe to forward again
+            while (!rtnObj && grow()) {
+                rtnObj = FreeListBase< T, Construct, Destroy, Stats >::tryConstruct(std::forward< Args >(args)...);
+            }
+            if (!rtnObj) {
+                FreeListBase< T, Construct, Destroy, Stats >::stats().failed();
+            }
+            return rtnObj;
+        }
+
+        // Construct a batch, growing the free list if it's exhausted and the growth policy permits
+        template< typename OutputIt, typename... Args >
+        size_t constructBatch(OutputIt out, const size_t count, const Args&... args) {
+            auto constructed = FreeListBase< T, Construct, Destroy, Stats >::constructInto(out, count, args...);
+            while (constructed < count && grow()) {
+                constructed += FreeListBase< T, Construct, Destroy, Stats >::constructInto(out, count - constructed, args...);
+            }
+            if (constructed < count) {
+                FreeListBase< T, Construct, Destroy, Stats >::stats().failed();
+            }
+            return constructed;
+        }
+
+        // Pop a single free slot, growing the free list if it's exhausted and the growth policy permits
+        FreeListNode* acquire() {
+            auto node = FreeListBase< T, Construct, Destroy, Stats >::acquire();
+            while (!node && grow()) {
+                node = FreeListBase< T, Construct, Destroy, Stats >::acquire();
+            }
+            return node;
+        }
+
+        // Pop up to count free slots as a single chain, growing the free list if it's exhausted and the growth
+        // policy permits
+        size_t acquire(const size_t count, FreeListNode*& first, FreeListNode*& last) {
+            auto acquired = FreeListBase< T, Construct, Destroy, Stats >::acquire(count, first, last);
+            while (acquired == 0 && count != 0 && grow()) {
+                acquired = FreeListBase< T, Construct, Destroy, Stats >::acquire(count, first, last);
+            }
+            return acquired;
+        }
+
+        // Total number of slots, excluding the sentinel
+        size_t capacity() const noexcept {
+            return m_capacity.load(std::memory_order_relaxed);
+        }
+
+        // The backing the initial slab actually came from, after any fallback. Kept apart from the slabs, which growth
+        // may reallocate concurrently
+        FreeListBacking::Mode backing() const noexcept {
+            return m_initialBacking;
+        }
+
+        // Release every grown slab whose slots are all free back to the OS, returning the number of slots released.
+        // The address range is kept, so a later growth recommits a released slab before allocating a new one.
+        // The initial slab is never released. Destroys may run concurrently, as may constructs for a multi-threaded
+        // construct policy, although those that find the pool exhausted wait for the trim rather than growing.
+        // Only mapped slabs are released, as a heap slab's pages can't be dropped without freeing it, and a pool
+        // with locked backing is never trimmed, as its pages are meant to stay resident
+        size_t trim() {
+            if (m_backing.lock()) {
+                return 0;
+            }
+
+            std::lock_guard< std::mutex > lock(m_growthMutex);
+
+            // Index the committed grown slabs by address, so each free node can be mapped back to its slab
+            std::vector< SlabRange > ranges;
+            for (size_t i = 1 ; i < m_slabs.size() ; ++i) {
+                if (m_slabs[i].m_committed && m_slabs[i].m_backing != FreeListBacking::Mode::Heap) {
+                    ranges.push_back({ m_slabs[i].m_array, m_slabs[i].m_array + m_slabs[i].m_size, i, 0 });
+                }
+            }
+            if (ranges.empty()) {
+                return 0;
+            }
+            std::sort(ranges.begin(), ranges.end(), [](const SlabRange& lhs, const SlabRange& rhs) {
+                return lhs.m_begin < rhs.m_begin;
+            });
+
+            auto findRange = [&ranges](FreeListNode* const node) -> SlabRange* {
+                auto slot = reinterpret_cast< AllocT* >(node);
+                auto it = std::upper_bound(ranges.begin(), ranges.end(), slot, [](const AllocT* lhs, const SlabRange& rhs) {
+                    return lhs < rhs.m_begin;
+                });
+                if (it == ranges.begin() || slot >= (--it)->m_end) {
+                    return nullptr;
+                }
+                return &*it;
+            };
+
+            auto isFree = [this](const SlabRange& range) {
+                return range.m_free == m_slabs[range.m_slab].m_size;
+            };
+
+            FreeListBase< T, Construct, Destroy, Stats >::filterFreeList(
+                    [&findRange](FreeListNode* const node) {
+                        if (auto range = findRange(node)) {
+                            ++range->m_free;
+                        }
+                    },
+                    [&findRange, &isFree](FreeListNode* const node) {
+                        auto range = findRange(node);
+                        return range && isFree(*range);
+                    });
+
+            size_t released = 0;
+            for (auto& range : ranges) {
+                if (isFree(range)) {
+                    auto& slab = m_slabs[range.m_slab];
+                    decommit(slab);
+                    released += slab.m_size;
+                }
+            }
+            m_capacity.fetch_sub(released, std::memory_order_relaxed);
+            return released;
+        }
+
+    private:
+        FreeListDynamic(const FreeListDynamic &) = delete;
+        FreeListDynamic(FreeListDynamic &&) = delete;
+        FreeListDynamic &operator=(const FreeListDynamic &) = delete;
+        FreeListDynamic &operator=(FreeListDynamic &) = delete;
+
+        using AllocT = FreeListAlloc<T>;
+
+        struct Slab {
+            AllocT*                     m_array;
+            size_t                      m_size;
+            bool                        m_committed;
+            FreeListBacking::Mode       m_backing;
+        };
+
+        struct SlabRange {
+            const AllocT*               m_begin;
+            const AllocT*               m_end;
+            size_t                      m_slab;
+            size_t                      m_free;
+        };
+
+        // The slab list starts with room for the initial slab, reserved before it is allocated so it can't leak. Called
+        // from the constructor's initialiser list, so m_slabs must be declared after m_backing, which it allocates from
+        std::vector< Slab > initialSlabs(const size_t size) const {
+            std::vector< Slab > slabs;
+            slabs.reserve(1);
+            slabs.push_back(allocateSlab(size));
+            return slabs;
+        }
+
+        Slab allocateSlab(const size_t size) const {
+            auto used = FreeListBacking::Mode::Heap;
+            auto array = reinterpret_cast< AllocT* >(m_backing.allocate(sizeof(AllocT) * size, alignof(AllocT), used));
+            if (!FreeListBase< T, Construct, Destroy, Stats >::addressable(array + size)) {
+                m_backing.deallocate(array, sizeof(AllocT) * size, used);
+                throw std::bad_alloc();
+            }
+            return { array, size, true, used };
+        }
+
+        // Drop the physical pages wholly inside a mapped slab. The anonymous mapping stays valid, and reads as zero, so
+        // a construct still holding a stale head from before the trim can safely read through it
+        static void decommit(Slab& slab) noexcept {
+            const auto pageSize = static_cast< uintptr_t >(FreeListBacking::pageSize(slab.m_backing));
+
+            auto begin = (reinterpret_cast< uintptr_t >(slab.m_array) + pageSize - 1) & ~(pageSize - 1);
+            auto end = reinterpret_cast< uintptr_t >(slab.m_array + slab.m_size) & ~(pageSize - 1);
+            if (begin < end) {
+                madvise(reinterpret_cast< void* >(begin), end - begin, MADV_DONTNEED);
+            }
+            slab.m_committed = false;
+        }
+
+        // Slow path - only taken once the free list is exhausted
+        bool grow() {
+            if (m_growth.mode() == FreeListGrowth::Mode::None) {
+                return false;
+            }
+
+            // A trim only detaches the free list while filtering it, so retry once it's reattached rather than grow
+            if (FreeListBase< T, Construct, Destroy, Stats >::filtering()) {
+                while (FreeListBase< T, Construct, Destroy, Stats >::filtering()) {
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+
+            std::lock_guard< std::mutex > lock(m_growthMutex);
+
+            // Another thread may have grown the list, or returned slots to it, while we waited for the lock
+            if (!FreeListBase< T, Construct, Destroy, Stats >::exhausted()) {
+                return true;
+            }
+
+            // Recommit a trimmed slab in preference to allocating a new one
+            auto capacity = m_capacity.load(std::memory_order_relaxed);
+            for (auto& slab : m_slabs) {
+                if (!slab.m_committed) {
+                    slab.m_committed = true;
+                    if (m_backing.prefault()) {
+                        FreeListBacking::touch(slab.m_array, sizeof(AllocT) * slab.m_size, slab.m_backing);
+                    }
+                    FreeListBase< T, Construct, Destroy, Stats >::extendFreeList(slab.m_array, slab.m_size, m_init.threads());
+                    m_capacity.store(capacity + slab.m_size, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            auto slabSize = m_growth.slabSize(capacity);
+            if (slabSize == 0) {
+                return false;
+            }
+
+            Slab slab{};
+            try {
+                slab = allocateSlab(slabSize);
+                m_slabs.push_back(slab);
+            }
+            catch (const std::exception&) {
+                // Treat a failure to allocate, or lock, the same as reaching the growth limit
+                if (slab.m_array) {
+                    m_backing.deallocate(slab.m_array, sizeof(AllocT) * slab.m_size, slab.m_backing);
+                }
+                return false;
+            }
+
+            FreeListBase< T, Construct, Destroy, Stats >::extendFreeList(m_slabs.back().m_array, slabSize, m_init.threads());
+            m_capacity.store(capacity + slabSize, std::memory_order_relaxed);
+            return true;
+        }
+
+        alignas(c_cacheLineSize) const FreeListGrowth   m_growth;
+        const FreeListBacking                           m_backing;
+        const FreeListInit                              m_init;
+        std::atomic< size_t >                           m_capacity;
+        std::mutex                                      m_growthMutex;
+        std::vector< Slab >                             m_slabs;            // After m_backing, see initialSlabs
+        const FreeListBacking::Mode                     m_initialBacking;   // After m_slabs, whose first slab sets it
+    };
+
+    // Periodically trims a FreeListDynamic from a background thread for as long as it's in scope
+    template< typename Pool >
+    class FreeListBackgroundTrim {
+    public:
+        static_assert(Pool::c_multiThreadedConstruct, "Background trimming requires a multi-threaded construct policy");
+
+        FreeListBackgroundTrim(Pool& pool, const std::chrono::milliseconds interval)
+                : m_pool(pool), m_interval(interval), m_stop(false), m_thread([this]() { run(); }) {
+        }
+
+        ~FreeListBackgroundTrim() {
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_one();
+            m_thread.join();
+        }
+
+    private:
+        FreeListBackgroundTrim(const FreeListBackgroundTrim &) = delete;
+        FreeListBackgroundTrim(FreeListBackgroundTrim &&) = delete;
+        FreeListBackgroundTrim &operator=(const FreeListBackgroundTrim &) = delete;
+        FreeListBackgroundTrim &operator=(FreeListBackgroundTrim &) = delete;
+
+        void run() {
+            std::unique_lock< std::mutex > lock(m_mutex);
+            while (!m_condition.wait_for(lock, m_interval, [this]() { return m_stop; })) {
+                m_pool.trim();
+            }
+        }
+
+        Pool&                           m_pool;
+        const std::chrono::milliseconds m_interval;
+        bool                            m_stop;
+        std::mutex                      m_mutex;
+        std::condition_variable         m_condition;
+        std::thread                     m_thread;
+    };
+
+    // Per-thread magazine caches in front of a multi-threaded pool. Each thread constructs from, and destroys to,
+    // a private stack of up to Capacity free slots, and only touches the shared free list to refill an empty
+    // magazine or flush a full one, half a magazine at a time. A thread's magazines are flushed back to their pools
+    // when it exits, or earlier through flush(). Free slots held in other threads' magazines are not visible to
+    // construct, so a pool may report exhaustion while up to Capacity slots per thread are cached elsewhere.
+    // Constructs and destroys through the magazines are counted in the pool's stats, as if made on the pool itself
+    template< typename Pool, size_t Capacity = 64 >
+    class FreeListMagazine {
+    public:
+        using T = typename Pool::value_type;
+        using StatsPolicy = typename Pool::StatsPolicy;
+        using Deleter = FreeListDeleter< T, FreeListMagazine >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        template< size_t BatchCapacity = 64 >
+        using BatchDeleter = FreeListBatchDeleter< T, FreeListMagazine, BatchCapacity >;
+
+        template< typename... PoolArgs >
+        explicit FreeListMagazine(PoolArgs&&... poolArgs)
+                : m_pool(std::forward< PoolArgs >(poolArgs)...)
+                , m_id(nextId())
+                , m_registration(std::make_shared< Registration >(this)) {
+            static_assert(Pool::c_multiThreadedConstruct && Pool::c_multiThreadedDestroy,
+                          "Magazines require multi-threaded construct and destroy policies");
+            static_assert(Capacity >= 2, "Capacity must be at least 2");
+        }
+
+        ~FreeListMagazine() {
+            // Magazines still held by other threads are dropped rather than flushed when those threads exit
+            std::lock_guard< std::mutex > lock(m_registration->m_mutex);
+            m_registration->m_owner = nullptr;
+        }
+
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto& magazine = threadMagazine();
+            if (magazine.m_count == 0 && !refill(magazine)) {
+                stats().failed();
+                return nullptr;
+            }
+
+            auto node = magazine.m_nodes[--magazine.m_count];
+            auto rtnObj = constructOrRepair<T, Args&&...>(
+                    [&]() { return new(reinterpret_cast< void * >(node)) FreeListAlloc<T>(this, std::forward<Args>(args)...); },
+                    // A constructor throw. Put node back in the magazine
+                    [&]() { magazine.m_nodes[magazine.m_count++] = node; });
+            stats().constructed();
+            return ptr(&rtnObj->m_data);
+        }
+
+        void destroy(FreeListAlloc<T>* const node) noexcept {
+            destroyAt(&node->m_data);
+            stats().destroyed();
+            auto freeNode = reinterpret_cast< FreeListNode* >(node);
+
+            Magazine* magazine = nullptr;
+            try {
+                magazine = &threadMagazine();
+            }
+            catch (...) {
+                // No magazine could be created for this thread, so go straight to the shared list
+                m_pool.release(freeNode, freeNode);
+                return;
+            }
+
+            if (magazine->m_count == Capacity) {
+                flush(*magazine, Capacity / 2);
+            }
+            magazine->m_nodes[magazine->m_count++] = freeNode;
+        }
+
+        // Return a pre-linked chain of unconstructed slots straight to the shared list
+        void release(FreeListNode* const first, FreeListNode* const last) noexcept {
+            m_pool.release(first, last);
+        }
+
+        // Return every slot cached by the calling thread to the shared list
+        void flush() noexcept {
+            Magazine* magazine = nullptr;
+            try {
+                magazine = &threadMagazine();
+            }
+            catch (...) {
+                // No magazine could be created for this thread, so it has nothing cached
+                return;
+            }
+            flush(*magazine, magazine->m_count);
+        }
+
+        Pool& pool() noexcept {
+            return m_pool;
+        }
+
+        StatsPolicy& stats() noexcept {
+            return m_pool.stats();
+        }
+
+        const StatsPolicy& stats() const noexcept {
+            return m_pool.stats();
+        }
+
+    private:
+        FreeListMagazine(const FreeListMagazine &) = delete;
+        FreeListMagazine(FreeListMagazine &&) = delete;
+        FreeListMagazine &operator=(const FreeListMagazine &) = delete;
+        FreeListMagazine &operator=(FreeListMagazine &) = delete;
+
+        // Outlives the owner, so an exiting thread can tell whether its magazine still has a pool to flush to
+        struct Registration {
+            explicit Registration(FreeListMagazine* const owner) noexcept
+                    : m_owner(owner) {
+            }
+
+            std::mutex                      m_mutex;
+            std::atomic< FreeListMagazine* > m_owner;
+        };
+
+        struct Magazine {
+            uint64_t                        m_id;
+            std::shared_ptr< Registration > m_registration;
+            size_t                          m_count;
+            FreeListNode*                   m_nodes[Capacity];
+        };
+
+        // All of a thread's magazines for this pool type, flushed when the thread exits
+        class ThreadMagazines {
+        public:
+            ThreadMagazines() = default;
+
+            ~ThreadMagazines() {
+                for (auto& magazine : m_magazines) {
+                    std::lock_guard< std::mutex > lock(magazine->m_registration->m_mutex);
+                    if (auto owner = magazine->m_registration->m_owner.load(std::memory_order_relaxed)) {
+                        owner->flush(*magazine, magazine->m_count);
+                    }
+                }
+            }
+
+            Magazine& find(const uint64_t id, const std::shared_ptr< Registration >& registration) {
+                if (m_last && m_last->m_id == id) {
+                    return *m_last;
+                }
+
+                for (auto& magazine : m_magazines) {
+                    if (magazine->m_id == id) {
+                        m_last = magazine.get();
+                        return *m_last;
+                    }
+                }
+
+                // Drop the magazines of pools that no longer exist before adding a new one
+                m_magazines.erase(std::remove_if(m_magazines.begin(), m_magazines.end(),
+                                                 [](const std::unique_ptr< Magazine >& magazine) {
+                                                     return magazine->m_registration->m_owner.load(std::memory_order_relaxed) == nullptr;
+                                                 }),
+                                  m_magazines.end());
+
+                m_magazines.push_back(std::unique_ptr< Magazine >(new Magazine{ id, registration, 0, {} }));
+                m_last = m_magazines.back().get();
+                return *m_last;
+            }
+
+        private:
+            ThreadMagazines(const ThreadMagazines &) = delete;
+            ThreadMagazines(ThreadMagazines &&) = delete;
+            ThreadMagazines &operator=(const ThreadMagazines &) = delete;
+            ThreadMagazines &operator=(ThreadMagazines &) = delete;
+
+            Magazine*                                   m_last = nullptr;
+            std::vector< std::unique_ptr< Magazine > >  m_magazines;
+        };
+
+        // Ids are never reused, unlike addresses, so a stale magazine can't be mistaken for a new pool's
+        static uint64_t nextId() noexcept {
+            static std::atomic< uint64_t > s_id(0);
+            return s_id.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        Magazine& threadMagazine() {
+            thread_local ThreadMagazines t_magazines;
+            return t_magazines.find(m_id, m_registration);
+        }
+
+        // Slow path - pull half a magazine from the shared list as a single chain
+        bool refill(Magazine& magazine) {
+            FreeListNode* first = nullptr;
+            FreeListNode* last = nullptr;
+            auto acquired = m_pool.acquire(Capacity / 2, first, last);
+
+            for (size_t i = 0 ; i < acquired ; ++i) {
+                magazine.m_nodes[magazine.m_count++] = first;
+                first = first->next();
+            }
+            return magazine.m_count != 0;
+        }
+
+        // Slow path - link the count coldest slots, at the bottom of the stack, and append them with a single exchange
+        void flush(Magazine& magazine, const size_t count) noexcept {
+            if (count == 0) {
+                return;
+            }
+
+            for (size_t i = 1 ; i < count ; ++i) {
+                magazine.m_nodes[i - 1]->setNext(magazine.m_nodes[i]);
+            }
+            m_pool.release(magazine.m_nodes[0], magazine.m_nodes[count - 1]);
+
+            std::copy(magazine.m_nodes + count, magazine.m_nodes + magazine.m_count, magazine.m_nodes);
+            magazine.m_count -= count;
+        }
+
+        Pool                                m_pool;
+        const uint64_t                      m_id;
+        std::shared_ptr< Registration >     m_registration;
+    };
+
+    // A fence pair for handshakes between a rarely taken slow side and a frequently taken fast side, where each side
+    // writes its own flag then reads the other's. Where the kernel supports it, the slow side runs a membarrier, which
+    // fences every running thread of the process, so the fast side only needs a compiler barrier. Otherwise both
+    // sides take a full fence
+    class FreeListAsymmetricFence {
+    public:
+        FreeListAsymmetricFence() noexcept
+                : m_expedited(syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0) {
+        }
+
+        void heavy() const noexcept {
+            if (m_expedited) {
+                syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+            }
+            else {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        void light() const noexcept {
+            if (m_expedited) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            }
+            else {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+    private:
+        const bool                      m_expedited;
+    };
+
+    // Blocking constructs in front of a pool. constructWait parks the calling thread on a futex while the pool is
+    // exhausted, and constructFor does so for at most a timeout. Destroys only make the wake syscall while a thread
+    // is parked, so construct and destroy cost the same as on the pool itself. Each freed slot wakes one parked
+    // thread, in the order the kernel queued them, which is FIFO among threads of equal priority, although a woken
+    // thread can still lose the slot to a construct that didn't wait, and then parks again. Only a chain of several
+    // slots wakes every parked thread, as its length isn't known
+    template< typename Pool >
+    class FreeListBlocking {
+    public:
+        using T = typename Pool::value_type;
+        using Deleter = FreeListDeleter< T, FreeListBlocking >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        template< size_t BatchCapacity = 64 >
+        using BatchDeleter = FreeListBatchDeleter< T, FreeListBlocking, BatchCapacity >;
+
+        using value_type = T;
+
+        static constexpr bool c_multiThreadedConstruct = Pool::c_multiThreadedConstruct;
+        static constexpr bool c_multiThreadedDestroy = Pool::c_multiThreadedDestroy;
+
+        template< typename... PoolArgs >
+        explicit FreeListBlocking(PoolArgs&&... poolArgs)
+                : m_pool(std::forward< PoolArgs >(poolArgs)...) {
+        }
+
+        ~FreeListBlocking() = default;
+
+        // Construct without waiting, returning nullptr if the pool is exhausted
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto node = m_pool.acquire();
+            if (!node) {
+                return nullptr;
+            }
+
+            auto rtnObj = constructOrRepair<T, Args&&...>(
+                    [&]() { return new(reinterpret_cast< void * >(node)) FreeListAlloc<T>(this, std::forward<Args>(args)...); },
+                    // A constructor throw. Return node to the pool, where a parked thread may take it
+                    [&]() { release(node, node); });
+            return ptr(&rtnObj->m_data);
+        }
+
+        // Construct, waiting for as long as it takes for a slot to be freed
+        template< typename... Args >
+        ptr constructWait(Args&&... args) {
+            if (auto rtnObj = construct(std::forward< Args >(args)...)) {
+                return rtnObj;
+            }
+            return constructParked(nullptr, std::forward< Args >(args)...);
+        }
+
+        // Construct, waiting for at most timeout for a slot to be freed, returning nullptr if none was. As with
+        // construct, a nullptr return leaves the arguments untouched
+        template< typename Rep, typename Period, typename... Args >
+        ptr constructFor(const std::chrono::duration< Rep, Period >& timeout, Args&&... args) {
+            if (auto rtnObj = construct(std::forward< Args >(args)...)) {
+                return rtnObj;
+            }
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast< std::chrono::steady_clock::duration >(timeout);
+            return constructParked(&deadline, std::forward< Args >(args)...);
+        }
+
+        void destroy(FreeListAlloc<T>* const node) noexcept {
+            destroyAt(&node->m_data);
+            auto freeNode = reinterpret_cast< FreeListNode* >(node);
+            m_pool.release(freeNode, freeNode);
+            wake(1);
+        }
+
+        // Return a pre-linked chain of unconstructed slots to the pool, waking one parked thread for a single slot,
+        // or every parked thread for a longer chain, as its length isn't known
+        void release(FreeListNode* const first, FreeListNode* const last) noexcept {
+            m_pool.release(first, last);
+            wake(first == last ? 1 : std::numeric_limits< int >::max());
+        }
+
+        // Number of threads currently parked, or about to park
+        size_t waiters() const noexcept {
+            return m_waiters.load(std::memory_order_relaxed);
+        }
+
+        Pool& pool() noexcept {
+            return m_pool;
+        }
+
+    private:
+        FreeListBlocking(const FreeListBlocking &) = delete;
+        FreeListBlocking(FreeListBlocking &&) = delete;
+        FreeListBlocking &operator=(const FreeListBlocking &) = delete;
+        FreeListBlocking &operator=(FreeListBlocking &) = delete;
+
+        // Slow path - register as a waiter, then retry and park until a construct succeeds or deadline passes.
+        // The waiter count is raised before the pool is retried, and destroys check it after freeing their slot, with
+        // an asymmetric fence between on each side, so either the retry sees the freed slot, or the destroy sees the
+        // waiter and bumps the sequence, which stops the park, or wakes it
+        template< typename... Args >
+        ptr constructParked(const std::chrono::steady_clock::time_point* const deadline, Args&&... args) {
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            m_fence.heavy();
+            struct Unregister {
+                ~Unregister() {
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+                std::atomic< size_t >&  m_waiters;
+            } unregister{ m_waiters };
+
+            while (true) {
+                auto sequence = m_sequence.load(std::memory_order_acquire);
+                if (auto rtnObj = construct(std::forward< Args >(args)...)) {
+                    return rtnObj;
+                }
+
+                timespec* timeout = nullptr;
+                timespec remaining;
+                if (deadline) {
+                    auto left = *deadline - std::chrono::steady_clock::now();
+                    if (left <= std::chrono::steady_clock::duration::zero()) {
+                        return nullptr;
+                    }
+                    auto seconds = std::chrono::duration_cast< std::chrono::seconds >(left);
+                    remaining.tv_sec = static_cast< time_t >(seconds.count());
+                    remaining.tv_nsec = static_cast< long >(std::chrono::duration_cast< std::chrono::nanoseconds >(left - seconds).count());
+                    timeout = &remaining;
+                }
+
+                // Returns at once if a destroy has bumped the sequence since it was read
+                syscall(SYS_futex, reinterpret_cast< uint32_t* >(&m_sequence), FUTEX_WAIT_PRIVATE, sequence, timeout, nullptr, 0);
+            }
+        }
+
+        void wake(const int count) noexcept {
+            m_fence.light();
+            if (m_waiters.load(std::memory_order_relaxed) != 0) {
+                m_sequence.fetch_add(1, std::memory_order_release);
+                syscall(SYS_futex, reinterpret_cast< uint32_t* >(&m_sequence), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+            }
+        }
+
+        static_assert(sizeof(std::atomic< uint32_t >) == sizeof(uint32_t), "The futex word must be a plain 32-bit int");
+
+        Pool                                        m_pool;
+        const FreeListAsymmetricFence               m_fence;
+        alignas(c_cacheLineSize) std::atomic< size_t >
+                                                    m_waiters{0};
+        std::atomic< uint32_t >                     m_sequence{0};
+    };
+
+    // Readiness notification in front of a pool, for reactors that must never block. fd() is an eventfd, to be
+    // polled for reading, that becomes readable once watermark slots have been freed since construct last found the
+    // pool exhausted, 1 by default. A reactor can stop reading its sockets on a nullptr construct, and resume once the
+    // eventfd is readable, calling clear() before it constructs again. Destroys only write the eventfd on that
+    // transition, so cost the same as on the pool itself otherwise. Readiness is a hint - a construct elsewhere may
+    // take the freed slots first, and the eventfd may occasionally become readable while the pool has free slots
+    template< typename Pool >
+    class FreeListEventFd {
+    public:
+        using T = typename Pool::value_type;
+        using Deleter = FreeListDeleter< T, FreeListEventFd >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        template< size_t BatchCapacity = 64 >
+        using BatchDeleter = FreeListBatchDeleter< T, FreeListEventFd, BatchCapacity >;
+
+        using value_type = T;
+
+        static constexpr bool c_multiThreadedConstruct = Pool::c_multiThreadedConstruct;
+        static constexpr bool c_multiThreadedDestroy = Pool::c_multiThreadedDestroy;
+
+        // Throws std::system_error if the eventfd can't be created
+        template< typename... PoolArgs >
+        explicit FreeListEventFd(PoolArgs&&... poolArgs)
+                : m_pool(std::forward< PoolArgs >(poolArgs)...)
+                , m_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+            if (m_fd == -1) {
+                throw std::system_error(errno, std::generic_category(), "eventfd");
+            }
+        }
+
+        ~FreeListEventFd() {
+            close(m_fd);
+        }
+
+        // Construct, returning nullptr if the pool is exhausted, in which case the eventfd is armed
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto rtnObj = tryConstruct(std::forward< Args >(args)...);
+            if (!rtnObj) {
+                // Arm before retrying, and destroys check the arming after freeing their slot, with an asymmetric
+                // fence between on each side, so either the retry sees the freed slot, or the destroy sees the arming
+                m_remaining.store(m_watermark.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                m_fence.heavy();
+                rtnObj = tryConstruct(std::forward< Args >(args)...);
+            }
+            return rtnObj;
+        }
+
+        void destroy(FreeListAlloc<T>* const node) noexcept {
+            destroyAt(&node->m_data);
+            auto freeNode = reinterpret_cast< FreeListNode* >(node);
+            m_pool.release(freeNode, freeNode);
+
+            m_fence.light();
+            auto remaining = m_remaining.load(std::memory_order_relaxed);
+            while (remaining != 0 &&
+                   !m_remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_relaxed)) {
+            }
+            if (remaining == 1) {
+                notify();
+            }
+        }
+
+        // Return a pre-linked chain of unconstructed slots to the pool, notifying if armed, as the chain's length
+        // isn't known
+        void release(FreeListNode* const first, FreeListNode* const last) noexcept {
+            m_pool.release(first, last);
+
+            m_fence.light();
+            if (m_remaining.load(std::memory_order_relaxed) != 0 &&
+                m_remaining.exchange(0, std::memory_order_relaxed) != 0) {
+                notify();
+            }
+        }
+
+        // The eventfd, which is non-blocking and close-on-exec, and owned by the pool
+        int fd() const noexcept {
+            return m_fd;
+        }
+
+        // Make the eventfd unreadable again, until the next notification
+        void clear() noexcept {
+            eventfd_t value;
+            eventfd_read(m_fd, &value);
+        }
+
+        // Number of slots to be freed after exhaustion before the eventfd becomes readable. Takes effect from the
+        // next exhaustion
+        void setWatermark(const size_t watermark) noexcept {
+            m_watermark.store(std::max< size_t >(watermark, 1), std::memory_order_relaxed);
+        }
+
+        Pool& pool() noexcept {
+            return m_pool;
+        }
+
+    private:
+        FreeListEventFd(const FreeListEventFd &) = delete;
+        FreeListEventFd(FreeListEventFd &&) = delete;
+        FreeListEventFd &operator=(const FreeListEventFd &) = delete;
+        FreeListEventFd &operator=(FreeListEventFd &) = delete;
+
+        template< typename... Args >
+        ptr tryConstruct(Args&&... args) {
+            auto node = m_pool.acquire();
+            if (!node) {
+                return nullptr;
+            }
+
+            auto rtnObj = constructOrRepair<T, Args&&...>(
+                    [&]() { return new(reinterpret_cast< void * >(node)) FreeListAlloc<T>(this, std::forward<Args>(args)...); },
+                    // A constructor throw. Return node to the pool, notifying if armed
+                    [&]() { release(node, node); });
+            return ptr(&rtnObj->m_data);
+        }
+
+        // A full counter only fails the write when the eventfd is already readable, so the result is ignored
+        void notify() noexcept {
+            eventfd_write(m_fd, 1);
+        }
+
+        Pool                                        m_pool;
+        const int                                   m_fd;
+        const FreeListAsymmetricFence               m_fence;
+        std::atomic< size_t >                       m_watermark{1};
+        alignas(c_cacheLineSize) std::atomic< size_t >
+                                                    m_remaining{0};
+    };
+
+    // Per-CPU sharded pool. Each shard is an MPMC FreeListDynamic, and construct takes from the shard of the CPU
+    // the caller is running on, stealing from the following shards when it is exhausted, and only growing the local
+    // shard once every shard is exhausted. Objects keep the shard's own deleter, so a destroy from any CPU returns
+    // the slot to the shard that owns it. Unlike thread-local caches, memory scales with CPUs rather than threads
+    template< typename T >
+    class FreeListSharded {
+    public:
+        using Shard = FreeListDynamic< T, FreeListMTConstruct, FreeListMTDestroy >;
+        using Deleter = typename Shard::Deleter;
+        using ptr = typename Shard::ptr;
+        using value_type = T;
+
+        explicit FreeListSharded(const size_t sizePerShard,
+                                 const size_t numShards = std::max(std::thread::hardware_concurrency(), 1U),
+                                 const FreeListGrowth growth = FreeListGrowth::none(),
+                                 const FreeListBacking backing = FreeListBacking::heap()) {
+            m_shards.reserve(numShards);
+            for (size_t i = 0 ; i < std::max< size_t >(numShards, 1) ; ++i) {
+                m_shards.push_back(std::make_unique< Shard >(sizePerShard, growth, backing));
+            }
+        }
+
+        ~FreeListSharded() = default;
+
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto local = localShard();
+
+            // A nullptr return doesn't consume the arguments, so they're safe to forward again
+            for (size_t i = 0 ; i < m_shards.size() ; ++i) {
+                auto& shard = *m_shards[(local + i) % m_shards.size()];
+                if (auto rtnObj = shard.FreeListBase< T, FreeListMTConstruct, FreeListMTDestroy >::construct(std::forward< Args >(args)...)) {
+                    return rtnObj;
+                }
+            }
+
+            return m_shards[local]->construct(std::forward< Args >(args)...);
+        }
+
+        size_t shards() const noexcept {
+            return m_shards.size();
+        }
+
+        Shard& shard(const size_t index) noexcept {
+            return *m_shards[index];
+        }
+
+        size_t capacity() const noexcept {
+            size_t capacity = 0;
+            for (auto& shard : m_shards) {
+                capacity += shard->capacity();
+            }
+            return capacity;
+        }
+
+        size_t trim() {
+            size_t released = 0;
+            for (auto& shard : m_shards) {
+                released += shard->trim();
+            }
+            return released;
+        }
+
+    private:
+        FreeListSharded(const FreeListSharded &) = delete;
+        FreeListSharded(FreeListSharded &&) = delete;
+        FreeListSharded &operator=(const FreeListSharded &) = delete;
+        FreeListSharded &operator=(FreeListSharded &) = delete;
+
+        // sched_getcpu reads the CPU id from the restartable sequences area, or the vDSO, without a system call.
+        // It may be stale as soon as it returns, which only costs locality, never correctness
+        size_t localShard() const noexcept {
+            auto cpu = sched_getcpu();
+            return cpu < 0 ? 0 : static_cast< size_t >(cpu) % m_shards.size();
+        }
+
+        std::vector< std::unique_ptr< Shard > > m_shards;
+    };
+
+    // The NUMA nodes of a machine, as the CPUs that belong to each, and how to find the CPU the caller is running on.
+    // Both can be supplied directly, so NUMA behaviour can be exercised with a fake topology on any machine
+    class FreeListNumaTopology {
+    public:
+        using CpuLookup = int (*)();
+
+        explicit FreeListNumaTopology(std::vector< std::vector< int > > nodes, const CpuLookup currentCpu = sched_getcpu)
+                : m_nodes(std::move(nodes)), m_currentCpu(currentCpu) {
+            if (m_nodes.empty()) {
+                m_nodes.emplace_back();
+            }
+        }
+
+        // Read from /sys/devices/system/node, falling back to a single node when that isn't available
+        static FreeListNumaTopology system() {
+            std::vector< std::vector< int > > nodes;
+            for (size_t node = 0 ; ; ++node) {
+                std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string cpus;
+                if (!std::getline(cpuList, cpus)) {
+                    break;
+                }
+                nodes.push_back(parseCpuList(cpus));
+            }
+            return FreeListNumaTopology(std::move(nodes));
+        }
+
+        size_t nodes() const noexcept {
+            return m_nodes.size();
+        }
+
+        const std::vector< int >& cpus(const size_t node) const noexcept {
+            return m_nodes[node];
+        }
+
+        // The node of the CPU the caller is running on, or node 0 if it can't be found. It may be stale as soon as it
+        // returns, which only costs locality, never correctness
+        size_t currentNode() const noexcept {
+            auto cpu = m_currentCpu();
+            for (size_t node = 0 ; node < m_nodes.size() ; ++node) {
+                if (std::find(m_nodes[node].begin(), m_nodes[node].end(), cpu) != m_nodes[node].end()) {
+                    return node;
+                }
+            }
+            return 0;
+        }
+
+    private:
+        // Parse a kernel CPU list, such as "0-3,8,10-11"
+        static std::vector< int > parseCpuList(const std::string& list) {
+            std::vector< int > cpus;
+            std::istringstream ranges(list);
+            std::string range;
+            while (std::getline(ranges, range, ',')) {
+                auto dash = range.find('-');
+                try {
+                    auto first = std::stoi(range.substr(0, dash));
+                    auto last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                    for (auto cpu = first ; cpu <= last ; ++cpu) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                catch (const std::logic_error&) {
+                    // A malformed range - the node just loses those CPUs
+                }
+            }
+            return cpus;
+        }
+
+        std::vector< std::vector< int > >   m_nodes;
+        CpuLookup                           m_currentCpu;
+    };
+
+    // NUMA-aware pool. Each node has its own MPMC FreeListDynamic, whose slabs are built and prefaulted on a thread
+    // pinned to the node's CPUs, so first touch places their pages on that node. That covers growth slabs too, as
+    // the thread that finds its node exhausted may since have migrated. Slabs are always prefaulted, as the pages of
+    // never-used slots would otherwise be first touched by whichever thread constructs into them. construct takes
+    // from the caller's node, growing it before falling back to remote nodes. Objects keep their node's own deleter,
+    // so a destroy from any node routes the slot back to the list of the node that owns it
+    template< typename T >
+    class FreeListNuma {
+    public:
+        using Shard = FreeListDynamic< T, FreeListMTConstruct, FreeListMTDestroy >;
+        using Deleter = typename Shard::Deleter;
+        using ptr = typename Shard::ptr;
+        using value_type = T;
+
+        explicit FreeListNuma(const size_t sizePerNode,
+                              FreeListNumaTopology topology = FreeListNumaTopology::system(),
+                              const FreeListGrowth growth = FreeListGrowth::none(),
+                              const FreeListBacking backing = FreeListBacking::heap())
+                : m_topology(std::move(topology)), m_growth(growth) {
+            m_shards.reserve(m_topology.nodes());
+            for (size_t node = 0 ; node < m_topology.nodes() ; ++node) {
+                const auto& cpus = m_topology.cpus(node);
+                auto shard = std::async(std::launch::async, [&cpus, sizePerNode, growth, backing]() {
+                    pinTo(cpus);
+                    return std::make_unique< Shard >(sizePerNode, growth, backing.withPrefault());
+                });
+                m_shards.push_back(shard.get());
+            }
+        }
+
+        ~FreeListNuma() = default;
+
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto local = m_topology.currentNode();
+            auto& localShard = *m_shards[local];
+
+            // A nullptr return doesn't consume the arguments, so they're safe to forward again
+            auto rtnObj = localShard.FreeListBase< T, FreeListMTConstruct, FreeListMTDestroy >::construct(std::forward< Args >(args)...);
+            while (!rtnObj && grow(local)) {
+                rtnObj = localShard.FreeListBase< T, FreeListMTConstruct, FreeListMTDestroy >::construct(std::forward< Args >(args)...);
+            }
+            if (rtnObj) {
+                return rtnObj;
+            }
+
+            for (size_t i = 1 ; i < m_shards.size() ; ++i) {
+                auto& shard = *m_shards[(local + i) % m_shards.size()];
+                if (auto rtnObj = shard.FreeListBase< T, FreeListMTConstruct, FreeListMTDestroy >::construct(std::forward< Args >(args)...)) {
+                    return rtnObj;
+                }
+            }
+
+            return nullptr;
+        }
+
+        size_t nodes() const noexcept {
+            return m_shards.size();
+        }
+
+        Shard& node(const size_t index) noexcept {
+            return *m_shards[index];
+        }
+
+        // The node whose slab holds p
+        size_t nodeOf(const T* const p) const noexcept {
+            auto allocator = FreeListAlloc< T >::fromData(const_cast< T* >(p))->m_allocator;
+            for (size_t node = 0 ; node < m_shards.size() ; ++node) {
+                if (allocator == static_cast< const FreeListBase< T, FreeListMTConstruct, FreeListMTDestroy >* >(m_shards[node].get())) {
+                    return node;
+                }
+            }
+            return m_shards.size();
+        }
+
+        const FreeListNumaTopology& topology() const noexcept {
+            return m_topology;
+        }
+
+        size_t capacity() const noexcept {
+            size_t capacity = 0;
+            for (auto& shard : m_shards) {
+                capacity += shard->capacity();
+            }
+            return capacity;
+        }
+
+        size_t trim() {
+            size_t released = 0;
+            for (auto& shard : m_shards) {
+                released += shard->trim();
+            }
+            return released;
+        }
+
+    private:
+        FreeListNuma(const FreeListNuma &) = delete;
+        FreeListNuma(FreeListNuma &&) = delete;
+        FreeListNuma &operator=(const FreeListNuma &) = delete;
+        FreeListNuma &operator=(FreeListNuma &) = delete;
+
+        // Pin the calling thread to as many of cpus as exist. If none do, as with a fake topology, the thread is left
+        // where it is, which only costs locality
+        static void pinTo(const std::vector< int >& cpus) noexcept {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (auto cpu : cpus) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+            sched_setaffinity(0, sizeof(set), &set);
+        }
+
+        // Slow path - grow an exhausted node from a thread pinned to it, so the new slab is first touched there.
+        // Growth hands that thread a slot, which goes straight back to the node for the caller to construct into
+        bool grow(const size_t node) {
+            auto& shard = *m_shards[node];
+            if (m_growth.slabSize(shard.capacity()) == 0) {
+                return false;
+            }
+
+            const auto& cpus = m_topology.cpus(node);
+            auto slot = std::async(std::launch::async, [&shard, &cpus]() {
+                pinTo(cpus);
+                return shard.acquire();
+            }).get();
+            if (!slot) {
+                return false;
+            }
+            shard.release(slot, slot);
+            return true;
+        }
+
+        FreeListNumaTopology                    m_topology;
+        const FreeListGrowth                    m_growth;
+        std::vector< std::unique_ptr< Shard > > m_shards;
+    };
+
+    // Deleter for pools without a per-object header, which find their pool from the slab an object lives in
+    template< typename T, typename Pool >
+    class FreeListSlabDeleter {
+    public:
+        void operator()(T *p) const noexcept {
+            Pool::owner(p)->destroy(p);
+        }
+    };
+
+    // A pool whose slots hold only T, with no per-object allocator pointer, so each slot is sizeof(T) rounded up to
+    // the alignment of T and FreeListNode. Storage is carved into SlabBytes sized slabs, aligned to SlabBytes, each
+    // starting with a header naming the pool, so masking an object's address finds its owner.
+    // Always link size + 1 slots, so the list has a sentinel if it's fully used
+    template< typename T, template < typename, class > class Construct, template < typename > class Destroy,
+              size_t SlabBytes = 64 * 1024 >
+    class FreeListSlab {
+    public:
+        using Deleter = FreeListSlabDeleter< T, FreeListSlab >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        using value_type = T;
+
+        static constexpr bool c_multiThreadedConstruct = Construct< T, FreeListSlab >::c_multiThreaded;
+        static constexpr bool c_multiThreadedDestroy = Destroy< T >::c_multiThreaded;
+
+    private:
+        struct SlabHeader {
+            FreeListSlab*               m_pool;
+        };
+
+        static constexpr size_t roundUp(const size_t size, const size_t align) noexcept {
+            return (size + align - 1) / align * align;
+        }
+
+    public:
+        static constexpr size_t c_slotAlign = std::max(alignof(T), alignof(FreeListNode));
+        static constexpr size_t c_slotSize = roundUp(sizeof(T), c_slotAlign);
+        static constexpr size_t c_headerSize = roundUp(sizeof(SlabHeader), c_slotAlign);
+        static constexpr size_t c_slotsPerSlab = SlabBytes > c_headerSize ? (SlabBytes - c_headerSize) / c_slotSize : 0;
+
+        explicit FreeListSlab(const size_t size, const FreeListGrowth growth = FreeListGrowth::none())
+                : m_growth(growth), m_capacity(size) {
+            static_assert(sizeof(T) >= sizeof(FreeListNode), "Size of T must be greater or equal to FreeListNode");
+            static_assert((SlabBytes & (SlabBytes - 1)) == 0, "SlabBytes must be a power of two");
+            static_assert(c_slotsPerSlab >= 1, "SlabBytes must hold at least one slot");
+            static_assert(Destroy< T >::c_reuse == FreeListReuse::Fifo, "Slab pools only support FIFO reuse");
+
+            m_regions.reserve(1);
+            FreeListNode* last = nullptr;
+            auto first = allocateRegion(size + 1, last);
+            last->setNext(nullptr);
+            m_construct.setHead(first);
+            m_destroy.setTail(last);
+        }
+
+        ~FreeListSlab() {
+            for (auto region : m_regions) {
+                std::free(region);
+            }
+        }
+
+        // Construct, growing the free list if it's exhausted and the growth policy permits
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto node = m_construct.acquire();
+            while (!node && grow()) {
+                node = m_construct.acquire();
+            }
+
+            if (node) {
+                return ptr(constructOrRepair< T, Args&&... >(
+                        [&]() { return new(reinterpret_cast< void * >(node)) T(std::forward< Args >(args)...); },
+                        // A constructor throw. Put node back in the list
+                        [&]() { m_construct.prepend(node, node); }));
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        void destroy(T* const p) noexcept {
+            destroyAt(p);
+            auto freeNode = reinterpret_cast< FreeListNode* >(p);
+            m_destroy.append(freeNode, freeNode);
+        }
+
+        // Destroy every object in a range of ptrs, all from this pool, leaving the ptrs null. The slots are linked
+        // privately and returned to the list with a single append
+        template< typename It >
+        void destroyBatch(It first, const It last) noexcept {
+            FreeListNode* chainFirst = nullptr;
+            FreeListNode* chainLast = nullptr;
+
+            for ( ; first != last ; ++first) {
+                if (auto obj = first->release()) {
+                    destroyAt(obj);
+
+                    auto freeNode = reinterpret_cast< FreeListNode* >(obj);
+                    if (chainLast) {
+                        chainLast->setNext(freeNode);
+                    }
+                    else {
+                        chainFirst = freeNode;
+                    }
+                    chainLast = freeNode;
+                }
+            }
+
+            if (chainLast) {
+                m_destroy.append(chainFirst, chainLast);
+            }
+        }
+
+        // The pool owning an object, read from the header of its slab
+        static FreeListSlab* owner(const T* const p) noexcept {
+            auto slab = reinterpret_cast< uintptr_t >(p) & ~static_cast< uintptr_t >(SlabBytes - 1);
+            return reinterpret_cast< const SlabHeader* >(slab)->m_pool;
+        }
+
+        // Total number of slots, excluding the sentinel
+        size_t capacity() const noexcept {
+            return m_capacity.load(std::memory_order_relaxed);
+        }
+
+    private:
+        FreeListSlab(const FreeListSlab &) = delete;
+        FreeListSlab(FreeListSlab &&) = delete;
+        FreeListSlab &operator=(const FreeListSlab &) = delete;
+        FreeListSlab &operator=(FreeListSlab &) = delete;
+
+        // Allocate enough contiguous slabs for size slots, write each slab's header, and link the slots in order,
+        // returning the first and last. The last node's next is left unset
+        FreeListNode* allocateRegion(const size_t size, FreeListNode*& last) {
+            auto numSlabs = (size + c_slotsPerSlab - 1) / c_slotsPerSlab;
+            auto region = reinterpret_cast< char* >(std::aligned_alloc(SlabBytes, numSlabs * SlabBytes));
+            if (region == nullptr) {
+                throw std::bad_alloc();
+            }
+            if (!Construct< T, FreeListSlab >::addressable(region + numSlabs * SlabBytes)) {
+                std::free(region);
+                throw std::bad_alloc();
+            }
+            try {
+                m_regions.push_back(region);
+            }
+            catch (...) {
+                std::free(region);
+                throw;
+            }
+
+            FreeListNode* first = nullptr;
+            last = nullptr;
+            size_t linked = 0;
+            for (size_t slab = 0 ; slab < numSlabs ; ++slab) {
+                auto slabStart = region + slab * SlabBytes;
+                new(reinterpret_cast< void * >(slabStart)) SlabHeader{ this };
+
+                for (size_t slot = 0 ; slot < c_slotsPerSlab && linked < size ; ++slot, ++linked) {
+                    auto freeNode = reinterpret_cast< FreeListNode* >(slabStart + c_headerSize + slot * c_slotSize);
+                    if (last) {
+                        last->setNext(freeNode);
+                    }
+                    else {
+                        first = freeNode;
+                    }
+                    last = freeNode;
+                }
+            }
+            return first;
+        }
+
+        // Slow path - only taken once the free list is exhausted
+        bool grow() {
+            if (m_growth.mode() == FreeListGrowth::Mode::None) {
+                return false;
+            }
+
+            std::lock_guard< std::mutex > lock(m_growthMutex);
+
+            // Another thread may have grown the list, or returned slots to it, while we waited for the lock
+            if (!m_construct.exhausted()) {
+                return true;
+            }
+
+            auto capacity = m_capacity.load(std::memory_order_relaxed);
+            auto slabSize = m_growth.slabSize(capacity);
+            if (slabSize == 0) {
+                return false;
+            }
+
+            FreeListNode* first = nullptr;
+            FreeListNode* last = nullptr;
+            try {
+                first = allocateRegion(slabSize, last);
+            }
+            catch (const std::bad_alloc&) {
+                // Treat a failure to allocate the same as reaching the growth limit
+                return false;
+            }
+
+            m_construct.prepend(first, last);
+            m_capacity.store(capacity + slabSize, std::memory_order_relaxed);
+            return true;
+        }
+
+        alignas(c_cacheLineSize) Construct< T, FreeListSlab >   m_construct;
+        alignas(c_cacheLineSize) Destroy< T >                   m_destroy;
+        alignas(c_cacheLineSize) const FreeListGrowth           m_growth;
+        std::atomic< size_t >                                   m_capacity;
+        std::mutex                                              m_growthMutex;
+        std::vector< char* >                                    m_regions;
+    };
+
+    // A pool of uninitialised blocks, whose size and alignment are given at runtime, for callers that construct into
+    // the memory themselves. Blocks are linked through the construct and destroy policies, over a stand-in element
+    // type, so allocate and deallocate are as thread safe as the policies, and lock free with the multi-threaded ones.
+    // There is no per-block header, so a block must be returned to the pool it came from.
+    // Always link size + 1 blocks, so the list has a sentinel if it's fully used
+    template< template < typename, class > class Construct, template < typename > class Destroy >
+    class FreeListRaw {
+    public:
+        static constexpr bool c_multiThreadedConstruct = Construct< std::byte, FreeListRaw >::c_multiThreaded;
+        static constexpr bool c_multiThreadedDestroy = Destroy< std::byte >::c_multiThreaded;
+
+        // A pool of size blocks of at least blockSize bytes, each aligned to blockAlign, which must be a power of two
+        FreeListRaw(const size_t blockSize, const size_t blockAlign, const size_t size,
+                    const FreeListGrowth growth = FreeListGrowth::none())
+                : m_blockAlign(std::max(blockAlign, alignof(FreeListNode)))
+                , m_blockSize((std::max(blockSize, sizeof(FreeListNode)) + m_blockAlign - 1) / m_blockAlign * m_blockAlign)
+                , m_growth(growth)
+                , m_capacity(size) {
+            static_assert(Destroy< std::byte >::c_reuse == FreeListReuse::Fifo, "Raw pools only support FIFO reuse");
+
+            m_regions.reserve(1);
+            FreeListNode* last = nullptr;
+            auto first = allocateRegion(size + 1, last);
+            last->setNext(nullptr);
+            m_construct.setHead(first);
+            m_destroy.setTail(last);
+        }
+
+        ~FreeListRaw() {
+            for (auto region : m_regions) {
+                std::free(region);
+            }
+        }
+
+        // Allocate a block, growing the free list if it's exhausted and the growth policy permits, or return nullptr
+        void* allocate() {
+            auto node = m_construct.acquire();
+            while (!node && grow()) {
+                node = m_construct.acquire();
+            }
+            return node;
+        }
+
+        void deallocate(void* const p) noexcept {
+            auto freeNode = reinterpret_cast< FreeListNode* >(p);
+            m_destroy.append(freeNode, freeNode);
+        }
+
+        size_t blockSize() const noexcept {
+            return m_blockSize;
+        }
+
+        size_t blockAlign() const noexcept {
+            return m_blockAlign;
+        }
+
+        // Total number of blocks, excluding the sentinel
+        size_t capacity() const noexcept {
+            return m_capacity.load(std::memory_order_relaxed);
+        }
+
+    private:
+        FreeListRaw(const FreeListRaw &) = delete;
+        FreeListRaw(FreeListRaw &&) = delete;
+        FreeListRaw &operator=(const FreeListRaw &) = delete;
+        FreeListRaw &operator=(FreeListRaw &) = delete;
+
+        // Allocate a region of size blocks and link them in order, returning the first and last. The last node's next
+        // is left unset
+        FreeListNode* allocateRegion(const size_t size, FreeListNode*& last) {
+            auto region = reinterpret_cast< char* >(std::aligned_alloc(m_blockAlign, size * m_blockSize));
+            if (region == nullptr) {
+                throw std::bad_alloc();
+            }
+            if (!Construct< std::byte, FreeListRaw >::addressable(region + size * m_blockSize)) {
+                std::free(region);
+                throw std::bad_alloc();
+            }
+            try {
+                m_regions.push_back(region);
+            }
+            catch (...) {
+                std::free(region);
+                throw;
+            }
+
+            auto first = reinterpret_cast< FreeListNode* >(region);
+            last = first;
+            for (size_t block = 1 ; block < size ; ++block) {
+                auto freeNode = reinterpret_cast< FreeListNode* >(region + block * m_blockSize);
+                last->setNext(freeNode);
+                last = freeNode;
+            }
+            return first;
+        }
+
+        // Slow path - only taken once the free list is exhausted
+        bool grow() {
+            if (m_growth.mode() == FreeListGrowth::Mode::None) {
+                return false;
+            }
+
+            std::lock_guard< std::mutex > lock(m_growthMutex);
+
+            // Another thread may have grown the list, or returned blocks to it, while we waited for the lock
+            if (!m_construct.exhausted()) {
+                return true;
+            }
+
+            auto capacity = m_capacity.load(std::memory_order_relaxed);
+            auto slabSize = m_growth.slabSize(capacity);
+            if (slabSize == 0) {
+                return false;
+            }
+
+            FreeListNode* first = nullptr;
+            FreeListNode* last = nullptr;
+            try {
+                first = allocateRegion(slabSize, last);
+            }
+            catch (const std::bad_alloc&) {
+                // Treat a failure to allocate the same as reaching the growth limit
+                return false;
+            }
+
+            m_construct.prepend(first, last);
+            m_capacity.store(capacity + slabSize, std::memory_order_relaxed);
+            return true;
+        }
+
+        alignas(c_cacheLineSize) Construct< std::byte, FreeListRaw >    m_construct;
+        alignas(c_cacheLineSize) Destroy< std::byte >                   m_destroy;
+        alignas(c_cacheLineSize) const size_t                           m_blockAlign;
+        const size_t                                                    m_blockSize;
+        const FreeListGrowth                                            m_growth;
+        std::atomic< size_t >                                           m_capacity;
+        std::mutex                                                      m_growthMutex;
+        std::vector< char* >                                            m_regions;
+    };
+
+    // A general purpose allocator for small blocks, routing each request to one of a fixed set of raw pools by size.
+    // Classes are the powers of two from c_minBlockSize to c_maxBlockSize, and each class's blocks are aligned to
+    // their size, so a request is served by the smallest class that covers both its size and alignment. Requests
+    // larger than c_maxBlockSize return nullptr, for the caller to serve elsewhere. Each class starts with, and grows
+    // by, a slab of slabBytes, up to maxBytes
+    template< template < typename, class > class Construct, template < typename > class Destroy >
+    class FreeListSizeClasses {
+    public:
+        using Pool = FreeListRaw< Construct, Destroy >;
+
+        static constexpr size_t c_minBlockSize = 8;
+        static constexpr size_t c_maxBlockSize = 4096;
+        static constexpr size_t c_classes = 10;
+
+        static_assert(c_minBlockSize << (c_classes - 1) == c_maxBlockSize, "Classes must span every power of two");
+
+        explicit FreeListSizeClasses(const size_t slabBytes = 64 * 1024,
+                                     const size_t maxBytes = std::numeric_limits< size_t >::max()) {
+            for (size_t i = 0 ; i < c_classes ; ++i) {
+                auto blockSize = c_minBlockSize << i;
+                auto slabSize = std::max< size_t >(slabBytes / blockSize, 1);
+                m_classes[i] = std::make_unique< Pool >(blockSize, blockSize, slabSize,
+                                                        FreeListGrowth::fixed(slabSize, std::max(maxBytes / blockSize, slabSize)));
+            }
+        }
+
+        ~FreeListSizeClasses() = default;
+
+        // Allocate bytes aligned to alignment, which must be a power of two, or return nullptr if the request is too
+        // large for any class, or its class is exhausted
+        void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t)) {
+            auto sizeClass = classOf(bytes, alignment);
+            return sizeClass < c_classes ? m_classes[sizeClass]->allocate() : nullptr;
+        }
+
+        // Return a block, given the same size and alignment it was allocated with
+        void deallocate(void* const p, const size_t bytes, const size_t alignment = alignof(std::max_align_t)) noexcept {
+            m_classes[classOf(bytes, alignment)]->deallocate(p);
+        }
+
+        // Whether a request can be served by one of the classes
+        static bool fits(const size_t bytes, const size_t alignment = alignof(std::max_align_t)) noexcept {
+            return std::max(bytes, alignment) <= c_maxBlockSize;
+        }
+
+        // The class serving a request, or c_classes if none can
+        static size_t classOf(const size_t bytes, const size_t alignment) noexcept {
+            auto size = std::max({ bytes, alignment, c_minBlockSize });
+            if (size > c_maxBlockSize) {
+                return c_classes;
+            }
+            // Round up to a power of two, and take its distance from the smallest class
+            return static_cast< size_t >(64 - __builtin_clzll(size - 1)) - 3;
+        }
+
+        Pool& pool(const size_t sizeClass) noexcept {
+            return *m_classes[sizeClass];
+        }
+
+    private:
+        FreeListSizeClasses(const FreeListSizeClasses &) = delete;
+        FreeListSizeClasses(FreeListSizeClasses &&) = delete;
+        FreeListSizeClasses &operator=(const FreeListSizeClasses &) = delete;
+        FreeListSizeClasses &operator=(FreeListSizeClasses &) = delete;
+
+        std::unique_ptr< Pool >         m_classes[c_classes];
+    };
+
+    // A std::pmr::memory_resource over a FreeListSizeClasses, so pmr containers allocate their nodes from the pools.
+    // Requests too large for any class are forwarded to an upstream resource, the default resource unless given.
+    // A class that is exhausted throws std::bad_alloc rather than falling back, so deallocate can tell where a block
+    // came from by its size and alignment alone. The resource is as thread safe as the policies it's built from
+    template< template < typename, class > class Construct, template < typename > class Destroy >
+    class FreeListMemoryResource : public std::pmr::memory_resource {
+    public:
+        using SizeClasses = FreeListSizeClasses< Construct, Destroy >;
+
+        explicit FreeListMemoryResource(std::pmr::memory_resource* const upstream = std::pmr::get_default_resource(),
+                                        const size_t slabBytes = 64 * 1024,
+                                        const size_t maxBytes = std::numeric_limits< size_t >::max())
+                : m_sizeClasses(slabBytes, maxBytes), m_upstream(upstream) {
+        }
+
+        ~FreeListMemoryResource() override = default;
+
+        std::pmr::memory_resource* upstream() const noexcept {
+            return m_upstream;
+        }
+
+        SizeClasses& sizeClasses() noexcept {
+            return m_sizeClasses;
+        }
+
+    protected:
+        void* do_allocate(const size_t bytes, const size_t alignment) override {
+            if (!SizeClasses::fits(bytes, alignment)) {
+                return m_upstream->allocate(bytes, alignment);
+            }
+
+            auto p = m_sizeClasses.allocate(bytes, alignment);
+            if (p == nullptr) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        void do_deallocate(void* const p, const size_t bytes, const size_t alignment) override {
+            if (!SizeClasses::fits(bytes, alignment)) {
+                m_upstream->deallocate(p, bytes, alignment);
+            }
+            else {
+                m_sizeClasses.deallocate(p, bytes, alignment);
+            }
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    private:
+        FreeListMemoryResource(const FreeListMemoryResource &) = delete;
+        FreeListMemoryResource(FreeListMemoryResource &&) = delete;
+        FreeListMemoryResource &operator=(const FreeListMemoryResource &) = delete;
+        FreeListMemoryResource &operator=(FreeListMemoryResource &) = delete;
+
+        SizeClasses                     m_sizeClasses;
+        std::pmr::memory_resource*      m_upstream;
+    };
+
+    // A standard Allocator whose single-object allocations come from a FreeListSizeClasses, so node-based containers
+    // allocate their nodes from the pools. Allocations of more than one object, such as a hash table's buckets, and
+    // objects too large for any class, are forwarded to std::allocator. The allocator only holds a pointer to the size
+    // classes, which every rebound copy shares, and which must outlive them. It propagates with its container, and
+    // copies compare equal while they share size classes. An exhausted class throws std::bad_alloc
+    template< typename T, typename SizeClasses = FreeListSizeClasses< FreeListMTConstruct, FreeListMTDestroy > >
+    class FreeListAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        template< typename U >
+        struct rebind {
+            using other = FreeListAllocator< U, SizeClasses >;
+        };
+
+        explicit FreeListAllocator(SizeClasses& sizeClasses) noexcept
+                : m_sizeClasses(&sizeClasses) {
+        }
+
+        template< typename U >
+        FreeListAllocator(const FreeListAllocator< U, SizeClasses >& other) noexcept
+                : m_sizeClasses(other.sizeClasses()) {
+        }
+
+        T* allocate(const size_t n) {
+            if (n == 1 && SizeClasses::fits(sizeof(T), alignof(T))) {
+                if (auto p = m_sizeClasses->allocate(sizeof(T), alignof(T))) {
+                    return static_cast< T* >(p);
+                }
+                throw std::bad_alloc();
+            }
+            return std::allocator< T >().allocate(n);
+        }
+
+        void deallocate(T* const p, const size_t n) noexcept {
+            if (n == 1 && SizeClasses::fits(sizeof(T), alignof(T))) {
+                m_sizeClasses->deallocate(p, sizeof(T), alignof(T));
+            }
+            else {
+                std::allocator< T >().deallocate(p, n);
+            }
+        }
+
+        SizeClasses* sizeClasses() const noexcept {
+            return m_sizeClasses;
+        }
+
+    private:
+        SizeClasses*                    m_sizeClasses;
+    };
+
+    template< typename T, typename U, typename SizeClasses >
+    bool operator==(const FreeListAllocator< T, SizeClasses >& lhs, const FreeListAllocator< U, SizeClasses >& rhs) noexcept {
+        return lhs.sizeClasses() == rhs.sizeClasses();
+    }
+
+    template< typename T, typename U, typename SizeClasses >
+    bool operator!=(const FreeListAllocator< T, SizeClasses >& lhs, const FreeListAllocator< U, SizeClasses >& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    // Index linked free list node, for pools whose slots are a single array known at compile time
+    template< typename Index >
+    class FreeListIndexNode {
+    public:
+        void setNext(const Index node) noexcept {
+            m_next.store(node, std::memory_order_release);
+        }
 
-        using AllocT = FreeListAlloc<T>;
-        typename std::aligned_storage< sizeof(AllocT), alignof(AllocT)>::type
-                                        m_array[N + 1];
+        Index next() const noexcept {
+            return m_next.load(std::memory_order_acquire);
+        }
+
+    private:
+        FreeListIndexNode() = default;
+        ~FreeListIndexNode() = default;
+
+        FreeListIndexNode(const FreeListIndexNode &) = delete;
+        FreeListIndexNode(FreeListIndexNode &&) = delete;
+        FreeListIndexNode &operator=(const FreeListIndexNode &) = delete;
+        FreeListIndexNode &operator=(FreeListIndexNode &&) = delete;
+
+        std::atomic< Index >            m_next;
     };
 
-    // Always allocate to size + 1, so array has a sentinel if it's fully used
-    template< typename T, template < typename, class > class Construct, template < typename > class Destroy >
-    class FreeListDynamic : public FreeListBase< T, Construct, Destroy > {
+    // The narrowest index able to address N + 1 slots, with the largest value reserved as null
+    template< size_t N >
+    using FreeListIndex = typename std::conditional< (N < std::numeric_limits< uint16_t >::max()), uint16_t, uint32_t >::type;
+
+    // Index linked policies. Slots is the pool, which maps an index to its node through slots.node(index)
+    // The head packs the index with a generation tag of the same width into one word, bumped on every update, so a
+    // pop can't succeed with a stale next after its head was recycled (ABA)
+    template< typename Index, typename Slots >
+    class FreeListIndexMTConstruct {
     public:
-        explicit FreeListDynamic(const size_t size) {
-            static_assert(sizeof(T) >= sizeof(FreeListNode), "Size of T must be greater or equal to FreeListNode");
+        static constexpr bool c_multiThreaded = true;
+        static constexpr Index c_null = std::numeric_limits< Index >::max();
 
-            if ( (m_array = reinterpret_cast< AllocT* >(std::aligned_alloc(alignof(AllocT), sizeof(AllocT) * (size + 1)))) == nullptr ) {
-                throw std::bad_alloc();
+        FreeListIndexMTConstruct() = default;
+        ~FreeListIndexMTConstruct() = default;
+
+        void setHead(const Index node) noexcept {
+            m_head.store(tagged(node, m_head.load(std::memory_order_relaxed)), std::memory_order_release);
+        }
+
+        bool exhausted(const Slots& slots) const noexcept {
+            return slots.node(index(m_head.load(std::memory_order_acquire))).next() == c_null;
+        }
+
+        Index head() const noexcept {
+            return index(m_head.load(std::memory_order_acquire));
+        }
+
+        // Multi-threaded prepend of a pre-linked chain - Lock free
+        void prepend(Slots& slots, const Index first, const Index last) noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            do {
+                slots.node(last).setNext(index(head));
+            } while (!m_head.compare_exchange_weak(head, tagged(first, head), std::memory_order_acq_rel, std::memory_order_acquire));
+        }
+
+        // Multi-threaded pop of a single free node, or c_null if only the sentinel remains - Lock free
+        Index acquire(Slots& slots) noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            Index next = c_null;
+            do {
+                next = slots.node(index(head)).next();
+            } while (next != c_null &&
+                     !m_head.compare_exchange_weak(head, tagged(next, head), std::memory_order_acq_rel, std::memory_order_acquire));
+
+            return next != c_null ? index(head) : c_null;
+        }
+
+    protected:
+        FreeListIndexMTConstruct(const FreeListIndexMTConstruct &) = delete;
+        FreeListIndexMTConstruct(FreeListIndexMTConstruct &&) = delete;
+        FreeListIndexMTConstruct &operator=(const FreeListIndexMTConstruct &) = delete;
+        FreeListIndexMTConstruct &operator=(FreeListIndexMTConstruct &) = delete;
+
+        using Word = typename std::conditional< sizeof(Index) == sizeof(uint16_t), uint32_t, uint64_t >::type;
+
+        static constexpr unsigned c_tagShift = sizeof(Index) * 8;
+
+        static Index index(const Word word) noexcept {
+            return static_cast< Index >(word);
+        }
+
+        // node, tagged with the generation following that of word
+        static Word tagged(const Index node, const Word word) noexcept {
+            return static_cast< Word >((((word >> c_tagShift) + 1) << c_tagShift) | node);
+        }
+
+        std::atomic< Word >             m_head{0};
+    };
+
+    template< typename Index, typename Slots >
+    class FreeListIndexSTConstruct {
+    public:
+        static constexpr bool c_multiThreaded = false;
+        static constexpr Index c_null = std::numeric_limits< Index >::max();
+
+        FreeListIndexSTConstruct() = default;
+        ~FreeListIndexSTConstruct() = default;
+
+        void setHead(const Index node) noexcept {
+            m_head = node;
+        }
+
+        bool exhausted(const Slots& slots) const noexcept {
+            return slots.node(m_head).next() == c_null;
+        }
+
+        Index head() const noexcept {
+            return m_head;
+        }
+
+        // Single-threaded prepend of a pre-linked chain - Wait free
+        void prepend(Slots& slots, const Index first, const Index last) noexcept {
+            slots.node(last).setNext(m_head);
+            m_head = first;
+        }
+
+        // Single-threaded pop of a single free node, or c_null if only the sentinel remains - Wait free
+        Index acquire(Slots& slots) noexcept {
+            auto head = m_head;
+            auto next = slots.node(head).next();
+
+            if (next != c_null) {
+                m_head = next;
+                return head;
+            }
+            else {
+                return c_null;
             }
-            FreeListBase< T, Construct, Destroy >::initFreeList(m_array, size);
         }
 
-        ~FreeListDynamic() {
-            std::free(m_array);
+    protected:
+        FreeListIndexSTConstruct(const FreeListIndexSTConstruct &) = delete;
+        FreeListIndexSTConstruct(FreeListIndexSTConstruct &&) = delete;
+        FreeListIndexSTConstruct &operator=(const FreeListIndexSTConstruct &) = delete;
+        FreeListIndexSTConstruct &operator=(FreeListIndexSTConstruct &) = delete;
+
+        Index                           m_head;
+    };
+
+    template< typename Index, typename Slots >
+    class FreeListIndexMTDestroy {
+    public:
+        static constexpr bool c_multiThreaded = true;
+        static constexpr Index c_null = std::numeric_limits< Index >::max();
+
+        FreeListIndexMTDestroy() = default;
+        ~FreeListIndexMTDestroy() = default;
+
+        void setTail(const Index node) noexcept {
+            m_tail.store(node, std::memory_order_release);
+        }
+
+        // Multi-threaded append of a pre-linked chain - Wait free
+        void append(Slots& slots, const Index first, const Index last) noexcept {
+            slots.node(last).setNext(c_null);
+            auto prevNode = m_tail.exchange(last, std::memory_order_acq_rel);
+            slots.node(prevNode).setNext(first);
+        }
+
+    protected:
+        FreeListIndexMTDestroy(const FreeListIndexMTDestroy &) = delete;
+        FreeListIndexMTDestroy(FreeListIndexMTDestroy &&) = delete;
+        FreeListIndexMTDestroy &operator=(const FreeListIndexMTDestroy &) = delete;
+        FreeListIndexMTDestroy &operator=(FreeListIndexMTDestroy &) = delete;
+
+        std::atomic< Index >            m_tail;
+    };
+
+    template< typename Index, typename Slots >
+    class FreeListIndexSTDestroy {
+    public:
+        static constexpr bool c_multiThreaded = false;
+        static constexpr Index c_null = std::numeric_limits< Index >::max();
+
+        FreeListIndexSTDestroy() = default;
+        ~FreeListIndexSTDestroy() = default;
+
+        void setTail(const Index node) noexcept {
+            m_tail = node;
+        }
+
+        // Single-threaded append of a pre-linked chain - Wait free
+        void append(Slots& slots, const Index first, const Index last) noexcept {
+            slots.node(last).setNext(c_null);
+            slots.node(m_tail).setNext(first);
+            m_tail = last;
+        }
+
+    protected:
+        FreeListIndexSTDestroy(const FreeListIndexSTDestroy &) = delete;
+        FreeListIndexSTDestroy(FreeListIndexSTDestroy &&) = delete;
+        FreeListIndexSTDestroy &operator=(const FreeListIndexSTDestroy &) = delete;
+        FreeListIndexSTDestroy &operator=(FreeListIndexSTDestroy &) = delete;
+
+        Index                           m_tail;
+    };
+
+    // Deleter for index linked pools, which carries its pool as there is no per-object header to find it from
+    template< typename T, typename Pool >
+    class FreeListIndexDeleter {
+    public:
+        FreeListIndexDeleter() noexcept
+                : m_pool(nullptr) {
+        }
+
+        explicit FreeListIndexDeleter(Pool* const pool) noexcept
+                : m_pool(pool) {
+        }
+
+        void operator()(T *p) const noexcept {
+            m_pool->destroy(p);
         }
 
     private:
-        FreeListDynamic(const FreeListDynamic &) = delete;
-        FreeListDynamic(FreeListDynamic &&) = delete;
-        FreeListDynamic &operator=(const FreeListDynamic &) = delete;
-        FreeListDynamic &operator=(FreeListDynamic &) = delete;
+        Pool*                           m_pool;
+    };
 
-        using AllocT = FreeListAlloc<T>;
-        AllocT*                         m_array;
+    // A static pool linked by slot index rather than pointer, with the index width picked from N, so a free slot
+    // needs only 2 or 4 bytes for its link. There is no per-object header, so each slot is sizeof(T) rounded up
+    // to the alignment of T and the index, and T may be as small as the index
+    // Always allocate to N + 1, so array has a sentinel if it's fully used
+    template< typename T, size_t N, template < typename, class > class Construct, template < typename, class > class Destroy >
+    class FreeListStaticIndexed {
+    public:
+        using Index = FreeListIndex< N >;
+        using Node = FreeListIndexNode< Index >;
+        using Deleter = FreeListIndexDeleter< T, FreeListStaticIndexed >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        using value_type = T;
+
+        static constexpr bool c_multiThreadedConstruct = Construct< Index, FreeListStaticIndexed >::c_multiThreaded;
+        static constexpr bool c_multiThreadedDestroy = Destroy< Index, FreeListStaticIndexed >::c_multiThreaded;
+        static constexpr size_t c_slotAlign = std::max(alignof(T), alignof(Node));
+        static constexpr size_t c_slotSize = (sizeof(T) + c_slotAlign - 1) / c_slotAlign * c_slotAlign;
+
+        FreeListStaticIndexed() noexcept {
+            static_assert(sizeof(T) >= sizeof(Node), "Size of T must be greater or equal to its index");
+            static_assert(N >= 1, "N must be greater than 0");
+
+            for (size_t i = 0 ; i < N ; ++i) {
+                node(static_cast< Index >(i)).setNext(static_cast< Index >(i + 1));
+            }
+            node(static_cast< Index >(N)).setNext(std::numeric_limits< Index >::max());
+
+            m_construct.setHead(0);
+            m_destroy.setTail(static_cast< Index >(N));
+        }
+
+        ~FreeListStaticIndexed() = default;
+
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto index = m_construct.acquire(*this);
+
+            if (index != std::numeric_limits< Index >::max()) {
+                return ptr(constructOrRepair< T, Args&&... >(
+                        [&]() { return new(slot(index)) T(std::forward< Args >(args)...); },
+                        // A constructor throw. Put the slot back in the list
+                        [&]() { m_construct.prepend(*this, index, index); }), Deleter(this));
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        void destroy(T* const p) noexcept {
+            destroyAt(p);
+            auto index = static_cast< Index >((reinterpret_cast< char* >(p) - reinterpret_cast< char* >(m_array)) / c_slotSize);
+            m_destroy.append(*this, index, index);
+        }
+
+        Node& node(const Index index) noexcept {
+            return *reinterpret_cast< Node* >(slot(index));
+        }
+
+        const Node& node(const Index index) const noexcept {
+            return *reinterpret_cast< const Node* >(&m_array[index]);
+        }
+
+    private:
+        FreeListStaticIndexed(const FreeListStaticIndexed &) = delete;
+        FreeListStaticIndexed(FreeListStaticIndexed &&) = delete;
+        FreeListStaticIndexed &operator=(const FreeListStaticIndexed &) = delete;
+        FreeListStaticIndexed &operator=(FreeListStaticIndexed &) = delete;
+
+        void* slot(const Index index) noexcept {
+            return &m_array[index];
+        }
+
+        alignas(c_cacheLineSize) Construct< Index, FreeListStaticIndexed >  m_construct;
+        alignas(c_cacheLineSize) Destroy< Index, FreeListStaticIndexed >    m_destroy;
+        alignas(c_cacheLineSize) typename std::aligned_storage< c_slotSize, c_slotAlign >::type
+                                                                            m_array[N + 1];
+    };
+
+    // An index linked pool whose header and slots are a single memory mapping, shared by the pools built on it. As
+    // links are slot indices and the policies live in the mapping, the pool works wherever the mapping is placed, in
+    // this process or another, and objects can be passed between mappings by index. There is no per-object header,
+    // and the deleter carries the pool's process-local address, so the mapping holds nothing that is only valid in
+    // the process that wrote it. T must be trivially copyable, as its objects may outlive the mapping that constructed
+    // them, and they are never destroyed by the pool
+    template< typename T, template < typename, class > class Construct, template < typename, class > class Destroy >
+    class FreeListMappedIndexed {
+    public:
+        using Index = uint32_t;
+        using Node = FreeListIndexNode< Index >;
+        using Deleter = FreeListIndexDeleter< T, FreeListMappedIndexed >;
+        using ptr = std::unique_ptr< T, Deleter >;
+        using value_type = T;
+
+        static constexpr bool c_multiThreadedConstruct = Construct< Index, FreeListMappedIndexed >::c_multiThreaded;
+        static constexpr bool c_multiThreadedDestroy = Destroy< Index, FreeListMappedIndexed >::c_multiThreaded;
+        static constexpr size_t c_slotAlign = std::max(alignof(T), alignof(Node));
+        static constexpr size_t c_slotSize = (sizeof(T) + c_slotAlign - 1) / c_slotAlign * c_slotAlign;
+        static constexpr Index c_null = std::numeric_limits< Index >::max();
+
+        template< typename... Args >
+        ptr construct(Args&&... args) {
+            auto index = m_header->m_construct.acquire(*this);
+
+            if (index != c_null) {
+                return ptr(constructOrRepair< T, Args&&... >(
+                        [&]() { return new(slot(index)) T(std::forward< Args >(args)...); },
+                        // A constructor throw. Put the slot back in the list
+                        [&]() { m_header->m_construct.prepend(*this, index, index); }), Deleter(this));
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        void destroy(T* const p) noexcept {
+            destroyAt(p);
+            m_header->m_destroy.append(*this, index(p), index(p));
+        }
+
+        // Visit each live object, such as those left by a previous process. The free list is walked to find them,
+        // so the pool must not be in use meanwhile
+        template< typename Visit >
+        void forEach(Visit&& visit) {
+            std::vector< bool > free(m_header->m_capacity + 1, false);
+            for (auto index = m_header->m_construct.head() ; index != c_null ; index = node(index).next()) {
+                free[index] = true;
+            }
+
+            for (size_t i = 0 ; i <= m_header->m_capacity ; ++i) {
+                if (!free[i]) {
+                    visit(*object(static_cast< Index >(i)));
+                }
+            }
+        }
+
+        // Take ownership of a live object, found by forEach or passed in by index
+        ptr adopt(T* const p) noexcept {
+            return ptr(p, Deleter(this));
+        }
+
+        // The index of an object, which identifies it in every mapping of the pool
+        Index index(const T* const p) const noexcept {
+            return static_cast< Index >((reinterpret_cast< const char* >(p) - m_slots) / c_slotSize);
+        }
+
+        // The object at index in this mapping
+        T* object(const Index index) noexcept {
+            return reinterpret_cast< T* >(slot(index));
+        }
+
+        // Write the pool's pages to its backing file, so they also survive a crash of the machine
+        void sync() {
+            if (msync(m_header, m_bytes, MS_SYNC) == -1) {
+                throw std::system_error(errno, std::generic_category(), "msync");
+            }
+        }
+
+        size_t capacity() const noexcept {
+            return m_header->m_capacity;
+        }
+
+        Node& node(const Index index) noexcept {
+            return *reinterpret_cast< Node* >(slot(index));
+        }
+
+        const Node& node(const Index index) const noexcept {
+            return *reinterpret_cast< const Node* >(m_slots + index * c_slotSize);
+        }
+
+    protected:
+        FreeListMappedIndexed() noexcept {
+            static_assert(std::is_trivially_copyable< T >::value, "T must be trivially copyable to be mapped");
+            static_assert(sizeof(T) >= sizeof(Node), "Size of T must be greater or equal to its index");
+        }
+
+        ~FreeListMappedIndexed() {
+            if (m_header) {
+                munmap(m_header, m_bytes);
+            }
+        }
+
+        FreeListMappedIndexed(const FreeListMappedIndexed &) = delete;
+        FreeListMappedIndexed(FreeListMappedIndexed &&) = delete;
+        FreeListMappedIndexed &operator=(const FreeListMappedIndexed &) = delete;
+        FreeListMappedIndexed &operator=(FreeListMappedIndexed &) = delete;
+
+        // Size fd for a pool of size slots, then map and initialise it
+        void create(const int fd, const size_t size, const std::string& name) {
+            if (size == 0 || size >= c_null) {
+                throw std::runtime_error("freelist: mapped pool size must be between 1 and " + std::to_string(c_null - 1));
+            }
+            if (ftruncate(fd, static_cast< off_t >(bytes(size))) == -1) {
+                throw std::system_error(errno, std::generic_category(), "ftruncate " + name);
+            }
+
+            map(fd, bytes(size), name);
+            initialise(size);
+        }
+
+        // Map the pool already in fd, which is checked to be compatible
+        void attach(const int fd, const std::string& name) {
+            struct stat status;
+            if (fstat(fd, &status) == -1) {
+                throw std::system_error(errno, std::generic_category(), "fstat " + name);
+            }
+            if (static_cast< size_t >(status.st_size) < c_slotsOffset) {
+                throw std::runtime_error("freelist: " + name + " is not a mapped pool");
+            }
+
+            map(fd, static_cast< size_t >(status.st_size), name);
+            if (!compatible()) {
+                munmap(m_header, m_bytes);
+                m_header = nullptr;
+                throw std::runtime_error("freelist: " + name + " holds an incompatible mapped pool");
+            }
+        }
+
+        // Reset the tail to the last node reachable from the head. Only safe while no other thread or process is using
+        // the pool. Throws std::runtime_error if the list doesn't end within the pool's slots
+        void repairTail(const std::string& name) {
+            auto last = m_header->m_construct.head();
+            for (size_t steps = 0 ; node(last).next() != c_null ; ++steps) {
+                if (steps > m_header->m_capacity) {
+                    throw std::runtime_error("freelist: " + name + " holds a corrupt free list");
+                }
+                last = node(last).next();
+            }
+            m_header->m_destroy.setTail(last);
+        }
+
+    private:
+        static constexpr uint64_t c_magic = 0x5453494c45455246;     // "FREELIST" in little-endian byte order
+        static constexpr uint32_t c_version = 1;
+
+        // Every field the mapping's layout depends on is recorded, so a pool of another type is refused. The magic is
+        // written last, so a pool whose creation was interrupted, or hasn't finished, is refused too
+        struct Header {
+            std::atomic< uint64_t >                                         m_magic;
+            uint32_t                                                        m_version;
+            uint32_t                                                        m_slotSize;
+            uint32_t                                                        m_slotAlign;
+            uint32_t                                                        m_multiThreaded;
+            uint64_t                                                        m_capacity;
+            alignas(c_cacheLineSize) Construct< Index, FreeListMappedIndexed > m_construct;
+            alignas(c_cacheLineSize) Destroy< Index, FreeListMappedIndexed >   m_destroy;
+        };
+
+        static constexpr size_t c_headerAlign = std::max(c_cacheLineSize, c_slotAlign);
+        static constexpr size_t c_slotsOffset = (sizeof(Header) + c_headerAlign - 1) / c_headerAlign * c_headerAlign;
+        static constexpr uint32_t c_multiThreaded = (c_multiThreadedConstruct ? 1U : 0U) | (c_multiThreadedDestroy ? 2U : 0U);
+
+        static size_t bytes(const size_t size) noexcept {
+            return c_slotsOffset + c_slotSize * (size + 1);
+        }
+
+        void map(const int fd, const size_t bytes, const std::string& name) {
+            auto mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap " + name);
+            }
+            m_header = static_cast< Header* >(mapped);
+            m_slots = static_cast< char* >(mapped) + c_slotsOffset;
+            m_bytes = bytes;
+        }
+
+        // Link every slot up front, as there is no bump pointer to keep in the mapping
+        void initialise(const size_t size) noexcept {
+            new(m_header) Header();
+            m_header->m_version = c_version;
+            m_header->m_slotSize = static_cast< uint32_t >(c_slotSize);
+            m_header->m_slotAlign = static_cast< uint32_t >(c_slotAlign);
+            m_header->m_multiThreaded = c_multiThreaded;
+            m_header->m_capacity = size;
+
+            for (size_t i = 0 ; i < size ; ++i) {
+                node(static_cast< Index >(i)).setNext(static_cast< Index >(i + 1));
+            }
+            node(static_cast< Index >(size)).setNext(c_null);
+
+            m_header->m_construct.setHead(0);
+            m_header->m_destroy.setTail(static_cast< Index >(size));
+            m_header->m_magic.store(c_magic, std::memory_order_release);
+        }
+
+        bool compatible() const noexcept {
+            return m_header->m_magic.load(std::memory_order_acquire) == c_magic &&
+                   m_header->m_version == c_version &&
+                   m_header->m_slotSize == c_slotSize &&
+                   m_header->m_slotAlign == c_slotAlign &&
+                   m_header->m_multiThreaded == c_multiThreaded &&
+                   m_bytes == bytes(m_header->m_capacity);
+        }
+
+        void* slot(const Index index) noexcept {
+            return m_slots + index * c_slotSize;
+        }
+
+        Header*                         m_header = nullptr;
+        char*                           m_slots = nullptr;
+        size_t                          m_bytes = 0;
+    };
+
+    // A mapped pool in a file, so the pool, and the objects live in it, survive a restart of the process. Opening an
+    // existing file reattaches to it in O(1), and forEach then visits each object that was live when it was last
+    // closed, which adopt can take ownership of again. Ptrs still held when the pool is destroyed must be released
+    // rather than reset, or their objects are lost. The file is locked while attached, so only one pool at a time may
+    // use it. Changes reach the file through the page cache, so survive a crash of the process, but not of the machine
+    // unless sync is called. A crash part way through a construct or destroy may leak the slot in flight, which
+    // forEach then reports as live. A destroy torn between publishing the new tail and linking it in would leave the
+    // tail on a chain the head can't reach, so reattaching walks the list from the head and resets the tail to its end
+    template< typename T, template < typename, class > class Construct, template < typename, class > class Destroy >
+    class FreeListPersistent : public FreeListMappedIndexed< T, Construct, Destroy > {
+    public:
+        // Open the pool in the file at path, creating it with size slots if it doesn't exist or is empty, or
+        // reattaching to it, with the size it was created with, if it does. Throws std::system_error if the file
+        // can't be opened, locked or mapped, and std::runtime_error if it holds a pool of another type
+        FreeListPersistent(const std::string& path, const size_t size) {
+            m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (m_fd == -1) {
+                throw std::system_error(errno, std::generic_category(), "open " + path);
+            }
+
+            try {
+                if (flock(m_fd, LOCK_EX | LOCK_NB) == -1) {
+                    throw std::system_error(errno, std::generic_category(), "flock " + path);
+                }
+
+                struct stat status;
+                if (fstat(m_fd, &status) == -1) {
+                    throw std::system_error(errno, std::generic_category(), "fstat " + path);
+                }
+
+                if (status.st_size == 0) {
+                    FreeListMappedIndexed< T, Construct, Destroy >::create(m_fd, size, path);
+                }
+                else {
+                    FreeListMappedIndexed< T, Construct, Destroy >::attach(m_fd, path);
+                    FreeListMappedIndexed< T, Construct, Destroy >::repairTail(path);
+                }
+            }
+            catch (...) {
+                close(m_fd);
+                throw;
+            }
+        }
+
+        ~FreeListPersistent() {
+            close(m_fd);
+        }
+
+    private:
+        FreeListPersistent(const FreeListPersistent &) = delete;
+        FreeListPersistent(FreeListPersistent &&) = delete;
+        FreeListPersistent &operator=(const FreeListPersistent &) = delete;
+        FreeListPersistent &operator=(FreeListPersistent &) = delete;
+
+        int                             m_fd = -1;
+    };
+
+    // A mapped pool in shared memory, such as a memfd or a POSIX shared memory object, for passing objects between
+    // processes. Each process maps the pool wherever it likes, and passes objects to another by index, which adopts
+    // them from its own mapping. With the multi-threaded policies, construct and destroy are lock free across
+    // processes as well as threads. One process creates the pool, and the others may only attach once it has been
+    // created. The fd isn't kept, so may be closed once the pool is. An object held by a process that dies is leaked
+    template< typename T, template < typename, class > class Construct, template < typename, class > class Destroy >
+    class FreeListShared : public FreeListMappedIndexed< T, Construct, Destroy > {
+    public:
+        // Create a pool of size slots in the empty shared memory object fd. Throws std::system_error if it can't be
+        // sized or mapped
+        FreeListShared(const int fd, const size_t size) {
+            static_assert(std::atomic< uint64_t >::is_always_lock_free, "Shared pools need address free atomics");
+            FreeListMappedIndexed< T, Construct, Destroy >::create(fd, size, "shared pool");
+        }
+
+        // Attach to the pool already created in fd. Throws std::system_error if it can't be mapped, and
+        // std::runtime_error if it holds a pool of another type, or one that hasn't finished being created
+        explicit FreeListShared(const int fd) {
+            FreeListMappedIndexed< T, Construct, Destroy >::attach(fd, "shared pool");
+        }
+
+        ~FreeListShared() = default;
+
+    private:
+        FreeListShared(const FreeListShared &) = delete;
+        FreeListShared(FreeListShared &&) = delete;
+        FreeListShared &operator=(const FreeListShared &) = delete;
+        FreeListShared &operator=(FreeListShared &) = delete;
     };
 
     template < typename T >
@@ -318,6 +3748,67 @@ namespace fl {
     using FreeListStaticMultipleProducerSingleConsumer      = FreeListStatic< T, N, FreeListMTConstruct, FreeListSTDestroy >;
     template < typename T, size_t N >
     using FreeListStaticMultipleProducerMultipleConsumer    = FreeListStatic< T, N, FreeListMTConstruct, FreeListMTDestroy >;
+
+    template < typename T, size_t N >
+    using FreeListStaticIndexedSingleProducerSingleConsumer     = FreeListStaticIndexed< T, N, FreeListIndexSTConstruct, FreeListIndexSTDestroy >;
+    template < typename T, size_t N >
+    using FreeListStaticIndexedSingleProducerMultipleConsumer   = FreeListStaticIndexed< T, N, FreeListIndexSTConstruct, FreeListIndexMTDestroy >;
+    template < typename T, size_t N >
+    using FreeListStaticIndexedMultipleProducerSingleConsumer   = FreeListStaticIndexed< T, N, FreeListIndexMTConstruct, FreeListIndexSTDestroy >;
+    template < typename T, size_t N >
+    using FreeListStaticIndexedMultipleProducerMultipleConsumer = FreeListStaticIndexed< T, N, FreeListIndexMTConstruct, FreeListIndexMTDestroy >;
+
+    template < typename T >
+    using FreeListPersistentSingleProducerSingleConsumer        = FreeListPersistent< T, FreeListIndexSTConstruct, FreeListIndexSTDestroy >;
+    template < typename T >
+    using FreeListPersistentSingleProducerMultipleConsumer      = FreeListPersistent< T, FreeListIndexSTConstruct, FreeListIndexMTDestroy >;
+    template < typename T >
+    using FreeListPersistentMultipleProducerSingleConsumer      = FreeListPersistent< T, FreeListIndexMTConstruct, FreeListIndexSTDestroy >;
+    template < typename T >
+    using FreeListPersistentMultipleProducerMultipleConsumer    = FreeListPersistent< T, FreeListIndexMTConstruct, FreeListIndexMTDestroy >;
+
+    template < typename T >
+    using FreeListSharedSingleProducerSingleConsumer            = FreeListShared< T, FreeListIndexSTConstruct, FreeListIndexSTDestroy >;
+    template < typename T >
+    using FreeListSharedSingleProducerMultipleConsumer          = FreeListShared< T, FreeListIndexSTConstruct, FreeListIndexMTDestroy >;
+    template < typename T >
+    using FreeListSharedMultipleProducerSingleConsumer          = FreeListShared< T, FreeListIndexMTConstruct, FreeListIndexSTDestroy >;
+    template < typename T >
+    using FreeListSharedMultipleProducerMultipleConsumer        = FreeListShared< T, FreeListIndexMTConstruct, FreeListIndexMTDestroy >;
+
+    using FreeListRawSingleProducerSingleConsumer               = FreeListRaw< FreeListSTConstruct, FreeListSTDestroy >;
+    using FreeListRawSingleProducerMultipleConsumer             = FreeListRaw< FreeListSTConstruct, FreeListMTDestroy >;
+    using FreeListRawMultipleProducerSingleConsumer             = FreeListRaw< FreeListMTConstruct, FreeListSTDestroy >;
+    using FreeListRawMultipleProducerMultipleConsumer           = FreeListRaw< FreeListMTConstruct, FreeListMTDestroy >;
+
+    using FreeListSizeClassesSingleProducerSingleConsumer       = FreeListSizeClasses< FreeListSTConstruct, FreeListSTDestroy >;
+    using FreeListSizeClassesSingleProducerMultipleConsumer     = FreeListSizeClasses< FreeListSTConstruct, FreeListMTDestroy >;
+    using FreeListSizeClassesMultipleProducerSingleConsumer     = FreeListSizeClasses< FreeListMTConstruct, FreeListSTDestroy >;
+    using FreeListSizeClassesMultipleProducerMultipleConsumer   = FreeListSizeClasses< FreeListMTConstruct, FreeListMTDestroy >;
+
+    using FreeListMemoryResourceSingleProducerSingleConsumer        = FreeListMemoryResource< FreeListSTConstruct, FreeListSTDestroy >;
+    using FreeListMemoryResourceSingleProducerMultipleConsumer      = FreeListMemoryResource< FreeListSTConstruct, FreeListMTDestroy >;
+    using FreeListMemoryResourceMultipleProducerSingleConsumer      = FreeListMemoryResource< FreeListMTConstruct, FreeListSTDestroy >;
+    using FreeListMemoryResourceMultipleProducerMultipleConsumer    = FreeListMemoryResource< FreeListMTConstruct, FreeListMTDestroy >;
+
+    // LIFO pools share the head between producers and consumers, so are single-threaded unless fully multi-threaded
+    template < typename T >
+    using FreeListDynamicLIFOSingleThreaded                 = FreeListDynamic< T, FreeListSTConstruct, FreeListLIFODestroy >;
+    template < typename T >
+    using FreeListDynamicLIFOMultiThreaded                  = FreeListDynamic< T, FreeListMTConstruct, FreeListLIFODestroy >;
+    template < typename T, size_t N >
+    using FreeListStaticLIFOSingleThreaded                  = FreeListStatic< T, N, FreeListSTConstruct, FreeListLIFODestroy >;
+    template < typename T, size_t N >
+    using FreeListStaticLIFOMultiThreaded                   = FreeListStatic< T, N, FreeListMTConstruct, FreeListLIFODestroy >;
+
+    template < typename T >
+    using FreeListSlabSingleProducerSingleConsumer          = FreeListSlab< T, FreeListSTConstruct, FreeListSTDestroy >;
+    template < typename T >
+    using FreeListSlabSingleProducerMultipleConsumer        = FreeListSlab< T, FreeListSTConstruct, FreeListMTDestroy >;
+    template < typename T >
+    using FreeListSlabMultipleProducerSingleConsumer        = FreeListSlab< T, FreeListMTConstruct, FreeListSTDestroy >;
+    template < typename T >
+    using FreeListSlabMultipleProducerMultipleConsumer      = FreeListSlab< T, FreeListMTConstruct, FreeListMTDestroy >;
 }
 
 #endif //FL_FREELIST_H
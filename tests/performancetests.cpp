@@ -2,14 +2,32 @@
 
 #include <freelist.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <ctime>
+#include <future>
 #include <iostream>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <numeric>
 #include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/pool/object_pool.hpp>
 
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 // Constants
 constexpr size_t c_perfFreeListSize = 100000;
+constexpr size_t c_hugePageFreeListSize = 4000000;
 
 // Types
 struct Timer
@@ -28,6 +46,96 @@ struct Timer
     std::chrono::steady_clock::time_point   m_start;
 };
 
+// Counts the dTLB read misses of this thread for as long as it's in scope, where the kernel exposes the counter
+struct TlbMissCounter
+{
+    TlbMissCounter()
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        m_fd = static_cast< int >(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~TlbMissCounter()
+    {
+        uint64_t misses = 0;
+        if (m_fd >= 0 && read(m_fd, &misses, sizeof(misses)) == sizeof(misses)) {
+            std::cout << "dTLB misses: " << misses << '\n';
+        }
+        else {
+            std::cout << "dTLB misses: unavailable" << '\n';
+        }
+
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    int                                     m_fd;
+};
+
+// Counts the last level cache misses of this thread for as long as it's in scope, where the kernel exposes the counter
+struct CacheMissCounter
+{
+    CacheMissCounter()
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        m_fd = static_cast< int >(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~CacheMissCounter()
+    {
+        uint64_t misses = 0;
+        if (m_fd >= 0 && read(m_fd, &misses, sizeof(misses)) == sizeof(misses)) {
+            std::cout << "Cache misses: " << misses << '\n';
+        }
+        else {
+            std::cout << "Cache misses: unavailable" << '\n';
+        }
+
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    int                                     m_fd;
+};
+
+// Counts the minor page faults of this thread for as long as it's in scope
+struct PageFaultCounter
+{
+    PageFaultCounter()
+        : m_start(faults())
+    {}
+
+    ~PageFaultCounter()
+    {
+        std::cout << "Page faults: " << faults() - m_start << '\n';
+    }
+
+    static long faults()
+    {
+        rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        return usage.ru_minflt;
+    }
+
+    long                                    m_start;
+};
+
 struct TestNode
 {
     TestNode(unsigned val1, unsigned val2)
@@ -46,6 +154,45 @@ struct TestNode
     unsigned    m_val2;
 };
 
+// As TestNode, but nothrow constructible, so construct skips the repair on throw
+struct NothrowNode
+{
+    NothrowNode(unsigned val1, unsigned val2) noexcept
+        : m_val1(val1)
+        , m_val2(val2)
+    {
+    }
+
+    unsigned    m_val1;
+    unsigned    m_val2;
+};
+
+// Copies its argument, so any extra copy on the way to the constructor costs an allocation
+struct StringNode
+{
+    explicit StringNode(const std::string& name)
+        : m_name(name)
+    {
+    }
+
+    std::string m_name;
+};
+
+// Spans several pages, and writes all of them on construction
+struct PageNode
+{
+    PageNode(unsigned val1, unsigned val2) noexcept
+        : m_val1(val1)
+        , m_val2(val2)
+    {
+        std::memset(m_data, 0xA5, sizeof(m_data));
+    }
+
+    unsigned    m_val1;
+    unsigned    m_val2;
+    char        m_data[8192];
+};
+
 struct RandomIndex
 {
     RandomIndex()
@@ -132,6 +279,17 @@ void testAgainstNewAndDelete(std::unique_ptr< T >& freeList)
         }
     }
 
+    for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+        (*nodes)[i] = freeList->construct(i, i);
+    }
+
+    {
+        std::cout << "Batch Free" << "\n";
+
+        Timer t;
+        freeList->destroyBatch(nodes->begin(), nodes->end());
+    }
+
     std::cout << "\n" << "New / Delete" << "\n";
 
     {
@@ -202,6 +360,168 @@ TEST(PerformanceTest, testAgainstNewAndDeleteDynamicMTMT)
     testAgainstNewAndDelete(freeList);
 }
 
+TEST(PerformanceTest, testAgainstNewAndDeleteSlabSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabSingleProducerSingleConsumer< TestNode > >(c_perfFreeListSize);
+    testAgainstNewAndDelete(freeList);
+}
+
+TEST(PerformanceTest, testAgainstNewAndDeleteSlabMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabMultipleProducerMultipleConsumer< TestNode > >(c_perfFreeListSize);
+    testAgainstNewAndDelete(freeList);
+}
+
+// Mixed small sizes, as a general purpose allocator sees them
+TEST(PerformanceTest, testSizeClassesAgainstMallocMTMT)
+{
+    constexpr size_t sizes[] = { 8, 24, 40, 64, 100, 256, 512, 1000 };
+    constexpr size_t numSizes = sizeof(sizes) / sizeof(sizes[0]);
+    auto sizeClasses = std::make_unique< fl::FreeListSizeClassesMultipleProducerMultipleConsumer >();
+    std::vector< void* > blocks(c_perfFreeListSize);
+
+    std::cout << "Size Classes" << "\n";
+    {
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            blocks[i] = sizeClasses->allocate(sizes[i % numSizes]);
+        }
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            sizeClasses->deallocate(blocks[i], sizes[i % numSizes]);
+        }
+    }
+
+    std::cout << "Malloc" << "\n";
+    {
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            blocks[i] = std::malloc(sizes[i % numSizes]);
+        }
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            std::free(blocks[i]);
+        }
+    }
+}
+
+// Fill and drain a list, map and unordered_map allocating from resource
+void testPmrContainers(std::pmr::memory_resource* const resource)
+{
+    {
+        std::cout << "List" << "\n";
+        Timer t;
+        std::pmr::list< TestNode > list(resource);
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            list.emplace_back(i, i);
+        }
+        list.clear();
+    }
+
+    {
+        std::cout << "Map" << "\n";
+        Timer t;
+        std::pmr::map< size_t, TestNode > map(resource);
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            map.emplace(i, TestNode(i, i));
+        }
+        map.clear();
+    }
+
+    {
+        std::cout << "Unordered Map" << "\n";
+        Timer t;
+        std::pmr::unordered_map< size_t, TestNode > unorderedMap(resource);
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            unorderedMap.emplace(i, TestNode(i, i));
+        }
+        unorderedMap.clear();
+    }
+}
+
+TEST(PerformanceTest, testMemoryResourceAgainstPmrPoolsSTST)
+{
+    std::cout << "FreeList" << "\n";
+    fl::FreeListMemoryResourceSingleProducerSingleConsumer freeListResource;
+    testPmrContainers(&freeListResource);
+
+    std::cout << "\n" << "Unsynchronized Pool" << "\n";
+    std::pmr::unsynchronized_pool_resource unsynchronizedResource;
+    testPmrContainers(&unsynchronizedResource);
+
+    std::cout << "\n" << "New / Delete" << "\n";
+    testPmrContainers(std::pmr::new_delete_resource());
+}
+
+TEST(PerformanceTest, testMemoryResourceAgainstPmrPoolsMTMT)
+{
+    std::cout << "FreeList" << "\n";
+    fl::FreeListMemoryResourceMultipleProducerMultipleConsumer freeListResource;
+    testPmrContainers(&freeListResource);
+
+    std::cout << "\n" << "Synchronized Pool" << "\n";
+    std::pmr::synchronized_pool_resource synchronizedResource;
+    testPmrContainers(&synchronizedResource);
+}
+
+// Fill and drain a list, map and unordered_map, each allocating through a copy of allocator
+template< typename Allocator >
+void testContainers(const Allocator& allocator)
+{
+    using MapAllocator = typename std::allocator_traits< Allocator >::template rebind_alloc< std::pair< const size_t, TestNode > >;
+
+    {
+        std::cout << "List" << "\n";
+        Timer t;
+        std::list< TestNode, Allocator > list(allocator);
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            list.emplace_back(i, i);
+        }
+        list.clear();
+    }
+
+    {
+        std::cout << "Map" << "\n";
+        Timer t;
+        std::map< size_t, TestNode, std::less< size_t >, MapAllocator > map{ MapAllocator(allocator) };
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            map.emplace(i, TestNode(i, i));
+        }
+        map.clear();
+    }
+
+    {
+        std::cout << "Unordered Map" << "\n";
+        Timer t;
+        std::unordered_map< size_t, TestNode, std::hash< size_t >, std::equal_to< size_t >, MapAllocator > unorderedMap{ MapAllocator(allocator) };
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            unorderedMap.emplace(i, TestNode(i, i));
+        }
+        unorderedMap.clear();
+    }
+}
+
+TEST(PerformanceTest, testAllocatorAgainstStdAllocatorSTST)
+{
+    using SizeClasses = fl::FreeListSizeClassesSingleProducerSingleConsumer;
+    SizeClasses sizeClasses;
+
+    std::cout << "FreeList" << "\n";
+    testContainers(fl::FreeListAllocator< TestNode, SizeClasses >(sizeClasses));
+
+    std::cout << "\n" << "std::allocator" << "\n";
+    testContainers(std::allocator< TestNode >());
+}
+
+TEST(PerformanceTest, testAllocatorAgainstStdAllocatorMTMT)
+{
+    fl::FreeListSizeClassesMultipleProducerMultipleConsumer sizeClasses;
+
+    std::cout << "FreeList" << "\n";
+    testContainers(fl::FreeListAllocator< TestNode >(sizeClasses));
+
+    std::cout << "\n" << "std::allocator" << "\n";
+    testContainers(std::allocator< TestNode >());
+}
+
 template< typename T >
 void testAgainstBoostObjectPool(std::unique_ptr< T >& freeList)
 {
@@ -302,4 +622,618 @@ TEST(PerformanceTest, testAgainstBoostObjectPoolDynamicMTMT)
 {
     auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(c_perfFreeListSize);
     testAgainstBoostObjectPool(freeList);
-}
\ No newline at end of file
+}
+
+template< typename T >
+void testStringArgumentAgainstNewAndDelete(std::unique_ptr< T >& freeList)
+{
+    const std::string name("A name long enough to defeat the small string optimisation");
+
+    auto nodes = std::make_unique< std::array< typename T::ptr, c_perfFreeListSize > >();
+    auto newedNodes = std::make_unique< std::array< std::unique_ptr< StringNode >, c_perfFreeListSize > >();
+
+    std::cout << "FreeList" << "\n";
+
+    {
+        std::cout << "Allocate" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            (*nodes)[i] = freeList->construct(name);
+        }
+    }
+
+    std::cout << "\n" << "New / Delete" << "\n";
+
+    {
+        std::cout << "Allocate" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            (*newedNodes)[i] = std::make_unique< StringNode >(name);
+        }
+    }
+}
+
+TEST(PerformanceTest, testStringArgumentAgainstNewAndDeleteDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< StringNode > >(c_perfFreeListSize);
+    testStringArgumentAgainstNewAndDelete(freeList);
+}
+
+template< typename T >
+void constructAndFree(std::unique_ptr< T >& freeList)
+{
+    auto nodes = std::make_unique< std::array< typename T::ptr, c_perfFreeListSize > >();
+
+    {
+        std::cout << "Allocate" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            (*nodes)[i] = freeList->construct(i, i);
+        }
+    }
+
+    {
+        std::cout << "Free" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            (*nodes)[i] = nullptr;
+        }
+    }
+}
+
+// The same node with and without a nothrow constructor, so the only difference is the repair on throw
+template< template < typename > class FreeList >
+void testNothrowAgainstThrowingConstruct()
+{
+    std::cout << "Throwing constructor" << "\n";
+    auto throwing = std::make_unique< FreeList< TestNode > >(c_perfFreeListSize);
+    constructAndFree(throwing);
+
+    std::cout << "\n" << "Nothrow constructor" << "\n";
+    auto nothrow = std::make_unique< FreeList< NothrowNode > >(c_perfFreeListSize);
+    constructAndFree(nothrow);
+}
+
+TEST(PerformanceTest, testNothrowAgainstThrowingConstructDynamicSTST)
+{
+    testNothrowAgainstThrowingConstruct< fl::FreeListDynamicSingleProducerSingleConsumer >();
+}
+
+TEST(PerformanceTest, testNothrowAgainstThrowingConstructDynamicMTMT)
+{
+    testNothrowAgainstThrowingConstruct< fl::FreeListDynamicMultipleProducerMultipleConsumer >();
+}
+
+// A free list far larger than the dTLB reaches with 4K pages, randomised so each construct lands on a new page
+template< typename T >
+void testHugePageBacking(const fl::FreeListBacking backing)
+{
+    auto freeList = std::make_unique< T >(c_hugePageFreeListSize, fl::FreeListGrowth::none(), backing);
+    auto nodes = std::make_unique< std::vector< typename T::ptr > >(c_hugePageFreeListSize);
+
+    std::vector< size_t > order(c_hugePageFreeListSize);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+
+    for (size_t i = 0 ; i < c_hugePageFreeListSize ; ++i) {
+        (*nodes)[i] = freeList->construct(i, i);
+    }
+    for (size_t i = 0 ; i < c_hugePageFreeListSize ; ++i) {
+        (*nodes)[order[i]] = nullptr;
+    }
+
+    std::cout << "Allocate" << "\n";
+
+    {
+        TlbMissCounter c;
+        Timer t;
+        for (size_t i = 0 ; i < c_hugePageFreeListSize ; ++i) {
+            (*nodes)[i] = freeList->construct(i, i);
+        }
+    }
+}
+
+TEST(PerformanceTest, testHugePageBackingDynamicSTST)
+{
+    using FreeList = fl::FreeListDynamicSingleProducerSingleConsumer< TestNode >;
+
+    std::cout << "Heap" << "\n";
+    testHugePageBacking< FreeList >(fl::FreeListBacking::heap());
+
+    std::cout << "\n" << "Transparent Huge Pages" << "\n";
+    testHugePageBacking< FreeList >(fl::FreeListBacking::transparentHugePages());
+}
+
+// Each request constructs a handful of objects, uses them and frees them. FIFO reuse walks the whole pool, so every
+// request touches cold slots, whereas LIFO keeps handing back the same few, still cached, slots
+template< typename T >
+void testReuseOrder()
+{
+    constexpr size_t size = 1000000;
+    constexpr size_t requests = 2000000;
+    constexpr size_t objectsPerRequest = 8;
+
+    auto freeList = std::make_unique< T >(size, fl::FreeListGrowth::none());
+    std::vector< typename T::ptr > nodes(size);
+
+    // Free every slot in a random order, as a long running pool would have, so walking the list isn't sequential
+    std::vector< size_t > order(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+    }
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[order[i]] = nullptr;
+    }
+
+    CacheMissCounter c;
+    Timer t;
+    unsigned sum = 0;
+    for (size_t request = 0 ; request < requests ; ++request) {
+        for (size_t i = 0 ; i < objectsPerRequest ; ++i) {
+            nodes[i] = freeList->construct(request, i);
+        }
+        for (size_t i = 0 ; i < objectsPerRequest ; ++i) {
+            sum += nodes[i]->m_val2;
+            nodes[i] = nullptr;
+        }
+    }
+    EXPECT_GT(sum, 0U);
+}
+
+TEST(PerformanceTest, testReuseOrderDynamic)
+{
+    std::cout << "FIFO" << "\n";
+    testReuseOrder< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >();
+
+    std::cout << "LIFO" << "\n";
+    testReuseOrder< fl::FreeListDynamicLIFOSingleThreaded< TestNode > >();
+
+    std::cout << "FIFO Multi-threaded" << "\n";
+    testReuseOrder< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >();
+
+    std::cout << "LIFO Multi-threaded" << "\n";
+    testReuseOrder< fl::FreeListDynamicLIFOMultiThreaded< TestNode > >();
+}
+
+template< typename T >
+void testPrefaultBacking(const fl::FreeListBacking backing)
+{
+    constexpr size_t size = 10000;
+
+    auto freeList = std::make_unique< T >(size, fl::FreeListGrowth::none(), backing);
+    std::vector< typename T::ptr > nodes(size);
+
+    std::cout << "Allocate" << "\n";
+
+    {
+        PageFaultCounter c;
+        Timer t;
+        for (size_t i = 0 ; i < size ; ++i) {
+            nodes[i] = freeList->construct(i, i);
+        }
+    }
+}
+
+TEST(PerformanceTest, testPrefaultBackingDynamicSTST)
+{
+    using FreeList = fl::FreeListDynamicSingleProducerSingleConsumer< PageNode >;
+
+    std::cout << "Heap" << "\n";
+    testPrefaultBacking< FreeList >(fl::FreeListBacking::heap());
+
+    std::cout << "\n" << "Heap Prefaulted" << "\n";
+    testPrefaultBacking< FreeList >(fl::FreeListBacking::heap().withPrefault());
+
+    std::cout << "\n" << "Heap Locked" << "\n";
+    try {
+        testPrefaultBacking< FreeList >(fl::FreeListBacking::heap().withLock());
+    }
+    catch (const std::system_error& ex) {
+        std::cout << ex.what() << '\n';
+    }
+}
+
+// Only the sentinel is linked up front, so construction takes the same time whatever the size
+TEST(PerformanceTest, testPoolConstructionDynamicSTST)
+{
+    constexpr size_t size = 50000000;
+
+    std::cout << "Construct " << size << " Slot Pool" << "\n";
+
+    std::unique_ptr< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > > freeList;
+    {
+        Timer t;
+        PageFaultCounter c;
+        freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(size);
+    }
+}
+
+template< typename T >
+void testPoolConstruction(const size_t size, const fl::FreeListInit init)
+{
+    std::unique_ptr< T > freeList;
+    {
+        Timer t;
+        PageFaultCounter c;
+        freeList = std::make_unique< T >(size, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), init);
+    }
+}
+
+// Eager initialisation touches every page, so its cost grows with the size, and is split across the threads
+TEST(PerformanceTest, testEagerPoolConstructionDynamicSTST)
+{
+    using FreeList = fl::FreeListDynamicSingleProducerSingleConsumer< TestNode >;
+
+    auto threads = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto size : { size_t(10000000), size_t(100000000) }) {
+        std::cout << "Construct " << size << " Slot Pool" << "\n";
+
+        std::cout << "Lazy" << "\n";
+        testPoolConstruction< FreeList >(size, fl::FreeListInit::lazy());
+
+        std::cout << "Eager 1 Thread" << "\n";
+        testPoolConstruction< FreeList >(size, fl::FreeListInit::eager());
+
+        std::cout << "Eager " << threads << " Threads" << "\n";
+        testPoolConstruction< FreeList >(size, fl::FreeListInit::eager(threads));
+    }
+}
+
+template< typename T >
+void constructDestroyThread(std::shared_ptr< T > freeList, const size_t numObjects)
+{
+    std::vector< typename T::ptr > nodes(numObjects);
+
+    for (size_t run = 0 ; run < 10 ; ++run) {
+        for (size_t i = 0 ; i < numObjects ; ++i) {
+            nodes[i] = freeList->construct(i, i);
+        }
+        for (size_t i = 0 ; i < numObjects ; ++i) {
+            nodes[i] = nullptr;
+        }
+    }
+}
+
+// A static pool over the same policies, with the head, tail and slots packed together rather than each on its own
+// cache line, as every pool was laid out before they were isolated
+template< typename T, size_t N, template < typename, class > class Construct, template < typename > class Destroy >
+class UnisolatedStatic
+{
+public:
+    using ptr = typename Construct< T, UnisolatedStatic >::ptr;
+
+    UnisolatedStatic() noexcept
+    {
+        auto array = reinterpret_cast< fl::FreeListAlloc< T >* >(m_array);
+        auto sentinel = reinterpret_cast< fl::FreeListNode* >(&array[N]);
+        sentinel->setNext(nullptr);
+
+        m_construct.setHead(sentinel);
+        m_destroy.setTail(sentinel);
+        m_construct.setBump(&array[0], &array[N]);
+    }
+
+    template< typename... Args >
+    ptr construct(Args&&... args)
+    {
+        return m_construct.construct(std::forward< Args >(args)...);
+    }
+
+    void destroy(fl::FreeListAlloc< T >* const node) noexcept
+    {
+        m_destroy.destroy(node);
+    }
+
+private:
+    using AllocT = fl::FreeListAlloc< T >;
+
+    Construct< T, UnisolatedStatic >    m_construct;
+    Destroy< T >                        m_destroy;
+    typename std::aligned_storage< sizeof(AllocT), alignof(AllocT) >::type
+                                        m_array[N + 1];
+};
+
+// Hands nodes from a producer thread to a consumer thread, each index on its own cache line, so the only shared
+// lines left are those of the pool itself
+template< typename T, size_t Capacity >
+struct PingPongRing
+{
+    alignas(fl::c_cacheLineSize) std::atomic< size_t > m_produced{0};
+    alignas(fl::c_cacheLineSize) std::atomic< size_t > m_consumed{0};
+    alignas(fl::c_cacheLineSize) typename T::ptr m_nodes[Capacity];
+};
+
+// The producer only constructs and the consumer only destroys, as in an SPSC pipeline, so the head and tail of the
+// pool are each written by one core
+template< typename T >
+void testPingPong(std::unique_ptr< T >& freeList, const size_t iterations)
+{
+    constexpr size_t capacity = 64;
+    auto ring = std::make_unique< PingPongRing< T, capacity > >();
+
+    Timer t;
+    auto consumer = std::async(std::launch::async, [&ring, iterations]() {
+        for (size_t i = 0 ; i < iterations ; ++i) {
+            while (ring->m_produced.load(std::memory_order_acquire) == i) {
+                std::this_thread::yield();
+            }
+            ring->m_nodes[i % capacity] = nullptr;
+            ring->m_consumed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    for (size_t i = 0 ; i < iterations ; ++i) {
+        while (i - ring->m_consumed.load(std::memory_order_acquire) == capacity) {
+            std::this_thread::yield();
+        }
+        ring->m_nodes[i % capacity] = freeList->construct(i, i);
+        ring->m_produced.store(i + 1, std::memory_order_release);
+    }
+    consumer.wait();
+}
+
+// With the head, tail and slots sharing a line, every construct invalidates the consumer's copy of the tail, and
+// every destroy the producer's copy of the head. Each pool is timed against an unisolated one with the same policies
+TEST(PerformanceTest, testPingPongStaticSTST)
+{
+    constexpr size_t iterations = 10000000;
+
+    std::cout << "Ping Pong " << iterations << " Nodes" << "\n";
+    std::cout << "Isolated" << "\n";
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 128 > >();
+    testPingPong(freeList, iterations);
+
+    std::cout << "\n" << "Unisolated" << "\n";
+    auto unisolated = std::make_unique< UnisolatedStatic< TestNode, 128, fl::FreeListSTConstruct, fl::FreeListSTDestroy > >();
+    testPingPong(unisolated, iterations);
+}
+
+TEST(PerformanceTest, testPingPongDynamicMTMT)
+{
+    constexpr size_t iterations = 10000000;
+
+    std::cout << "Ping Pong " << iterations << " Nodes" << "\n";
+    std::cout << "Isolated" << "\n";
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(128);
+    testPingPong(freeList, iterations);
+
+    // A dynamic pool's slots are in their own slab anyway, so only the head and tail share a line here
+    std::cout << "\n" << "Unisolated" << "\n";
+    auto unisolated = std::make_unique< UnisolatedStatic< TestNode, 128, fl::FreeListMTConstruct, fl::FreeListMTDestroy > >();
+    testPingPong(unisolated, iterations);
+}
+
+// Every thread does the same amount of work, so perfect scaling keeps the time constant
+template< typename T >
+void testThreadScaling(std::shared_ptr< T > freeList)
+{
+    constexpr size_t maxThreads = 8;
+
+    for (size_t numThreads = 1 ; numThreads <= maxThreads ; numThreads *= 2) {
+        std::cout << numThreads << " Threads" << "\n";
+
+        Timer t;
+        std::vector< std::future< void > > fut(numThreads);
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i] = std::async(std::launch::async, constructDestroyThread< T >, freeList, c_perfFreeListSize / maxThreads);
+        }
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i].wait();
+        }
+    }
+}
+
+TEST(PerformanceTest, testThreadScalingDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+// Compare against testThreadScalingDynamicMTMT for the cost of keeping stats
+TEST(PerformanceTest, testThreadScalingStatsDynamicMTMT)
+{
+    using FreeList = fl::FreeListDynamic< TestNode, fl::FreeListMTConstruct, fl::FreeListMTDestroy, fl::FreeListStats >;
+    auto freeList = std::make_shared< FreeList >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+
+    auto snapshot = freeList->stats().snapshot();
+    std::cout << "Constructs: " << snapshot.m_constructs << " Destroys: " << snapshot.m_destroys
+              << " Failures: " << snapshot.m_failures << " CAS retries: " << snapshot.m_casRetries
+              << " High watermark: " << snapshot.m_highWatermark << '\n';
+}
+
+// Compare against testThreadScalingDynamicMTMT for the cost of index links into a file mapping
+TEST(PerformanceTest, testThreadScalingPersistentMTMT)
+{
+    auto path = "/tmp/freelist_perf_persistent_" + std::to_string(getpid());
+    unlink(path.c_str());
+    {
+        auto freeList = std::make_shared< fl::FreeListPersistentMultipleProducerMultipleConsumer< TestNode > >(path, c_perfFreeListSize);
+        testThreadScaling(freeList);
+    }
+    unlink(path.c_str());
+}
+
+// Compare against testThreadScalingDynamicMTMT for the cost of the blocking wrapper's non-waiting path
+TEST(PerformanceTest, testThreadScalingBlockingDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListBlocking< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+// Compare against testThreadScalingDynamicMTMT for the cost of the eventfd wrapper's destroy check
+TEST(PerformanceTest, testThreadScalingEventFdDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListEventFd< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+// Many more threads than slots, each retrying until it gets one, either by spinning or by parking
+template< typename T, typename Construct >
+void testBackpressure(std::shared_ptr< T > freeList, Construct construct)
+{
+    constexpr size_t numThreads = 8;
+    constexpr size_t iterations = 20000;
+
+    auto cpuStart = std::clock();
+    {
+        Timer t;
+        std::vector< std::future< void > > fut(numThreads);
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i] = std::async(std::launch::async, [freeList, construct]() {
+                for (size_t j = 0 ; j < iterations ; ++j) {
+                    auto node = construct(*freeList, j);
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i].wait();
+        }
+    }
+    std::cout << "CPU time: " << static_cast< double >(std::clock() - cpuStart) / CLOCKS_PER_SEC << '\n';
+}
+
+TEST(PerformanceTest, testBackpressureBlockingDynamicMTMT)
+{
+    using FreeList = fl::FreeListBlocking< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >;
+
+    std::cout << "Spin" << "\n";
+    testBackpressure(std::make_shared< FreeList >(2), [](FreeList& freeList, const size_t i) {
+        auto node = freeList.construct(i, i);
+        while (!node) {
+            std::this_thread::yield();
+            node = freeList.construct(i, i);
+        }
+        return node;
+    });
+
+    std::cout << "Wait" << "\n";
+    testBackpressure(std::make_shared< FreeList >(2), [](FreeList& freeList, const size_t i) {
+        return freeList.constructWait(i, i);
+    });
+}
+
+TEST(PerformanceTest, testThreadScalingMagazineDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+TEST(PerformanceTest, testThreadScalingSharded)
+{
+    auto freeList = std::make_shared< fl::FreeListSharded< TestNode > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+TEST(PerformanceTest, testThreadScalingNuma)
+{
+    auto freeList = std::make_shared< fl::FreeListNuma< TestNode > >(c_perfFreeListSize);
+    testThreadScaling(freeList);
+}
+
+// Hold only a couple of nodes at a time, so every thread hammers the head, and check each node is still ours on
+// release, which an ABA pop handing the same slot to two threads would break
+template< typename T >
+void stressThread(std::shared_ptr< T > freeList, const unsigned id, const size_t numIterations)
+{
+    for (size_t i = 0 ; i < numIterations ; ++i) {
+        auto first = freeList->construct(id, static_cast< unsigned >(i));
+        auto second = freeList->construct(id, static_cast< unsigned >(i + 1));
+        ASSERT_TRUE(first && second);
+
+        std::this_thread::yield();
+
+        EXPECT_EQ(first->m_val1, id);
+        EXPECT_EQ(first->m_val2, i);
+        EXPECT_EQ(second->m_val1, id);
+        EXPECT_EQ(second->m_val2, i + 1);
+    }
+}
+
+// The total work is split across the threads, so the time shows the pool's throughput under increasing contention
+template< typename T >
+void testStress(std::shared_ptr< T > freeList)
+{
+    constexpr size_t maxThreads = 64;
+    constexpr size_t totalIterations = 200000;
+
+    for (size_t numThreads = 1 ; numThreads <= maxThreads ; numThreads *= 2) {
+        std::cout << numThreads << " Threads" << "\n";
+
+        Timer t;
+        std::vector< std::future< void > > fut(numThreads);
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i] = std::async(std::launch::async, stressThread< T >, freeList, static_cast< unsigned >(i), totalIterations / numThreads);
+        }
+        for (size_t i = 0 ; i < numThreads ; ++i) {
+            fut[i].wait();
+        }
+    }
+}
+
+TEST(PerformanceTest, testStressStaticMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, 256 > >();
+    testStress(freeList);
+}
+
+TEST(PerformanceTest, testStressStaticIndexedMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListStaticIndexedMultipleProducerMultipleConsumer< TestNode, 256 > >();
+    testStress(freeList);
+}
+
+template< typename T >
+void testConstructBatch(std::unique_ptr< T >& freeList)
+{
+    constexpr size_t batchSize = 32;
+
+    randomiseFreeList(freeList);
+
+    auto nodes = std::make_unique< std::array< typename T::ptr, c_perfFreeListSize > >();
+
+    std::cout << "FreeList" << "\n";
+
+    {
+        std::cout << "Allocate" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+            (*nodes)[i] = freeList->construct(1U, 2U);
+        }
+    }
+
+    for (size_t i = 0 ; i < c_perfFreeListSize ; ++i) {
+        (*nodes)[i] = nullptr;
+    }
+
+    std::cout << "\n" << "FreeList Batch of " << batchSize << "\n";
+
+    {
+        std::cout << "Allocate" << "\n";
+
+        Timer t;
+        for (size_t i = 0 ; i < c_perfFreeListSize ; i += batchSize) {
+            freeList->constructBatch(nodes->begin() + i, std::min(batchSize, c_perfFreeListSize - i), 1U, 2U);
+        }
+    }
+}
+
+TEST(PerformanceTest, testConstructBatchDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(c_perfFreeListSize);
+    testConstructBatch(freeList);
+}
+
+TEST(PerformanceTest, testConstructBatchDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(c_perfFreeListSize);
+    testConstructBatch(freeList);
+}
@@ -3,7 +3,20 @@
 #include <freelist.h>
 
 #include <vector>
+#include <cstring>
+#include <functional>
 #include <future>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
 
 // Constants
 constexpr size_t c_freeListSize = 10000000;
@@ -71,6 +84,89 @@ struct ExceptionNode
     bool        m_throwException;
 };
 
+// Throws from the constructor once the shared countdown reaches zero
+struct CountdownNode
+{
+    explicit CountdownNode(size_t& countdown)
+        : m_val1(0)
+        , m_val2(0)
+    {
+        if (countdown-- == 0) {
+            throw std::runtime_error("Test Exception");
+        }
+    }
+
+    unsigned    m_val1;
+    unsigned    m_val2;
+};
+
+// Counts the copies made of it on the way to a constructor
+struct CopyCounter
+{
+    CopyCounter() = default;
+
+    CopyCounter(const CopyCounter& other)
+        : m_copies(other.m_copies + 1)
+    {
+    }
+
+    unsigned    m_copies = 0;
+};
+
+struct ForwardNode
+{
+    explicit ForwardNode(const CopyCounter& counter)
+        : m_copies(counter.m_copies)
+        , m_val1(0)
+    {
+    }
+
+    unsigned    m_copies;
+    unsigned    m_val1;
+};
+
+// Takes ownership of its argument, so a consumed argument is left null
+struct MoveNode
+{
+    explicit MoveNode(std::unique_ptr< unsigned >&& val)
+        : m_val(std::move(val))
+    {
+    }
+
+    std::unique_ptr< unsigned > m_val;
+};
+
+// Counts its destructions through a shared counter
+struct DestructorNode
+{
+    explicit DestructorNode(size_t& destroyed)
+        : m_destroyed(&destroyed)
+    {
+    }
+
+    ~DestructorNode()
+    {
+        ++*m_destroyed;
+    }
+
+    size_t*     m_destroyed;
+};
+
+// Spans several pages, and writes all of them on construction
+struct PageNode
+{
+    PageNode(unsigned val1, unsigned val2)
+        : m_val1(val1)
+        , m_val2(val2)
+    {
+        std::memset(m_data, 0xA5, sizeof(m_data));
+    }
+
+    unsigned    m_val1;
+    unsigned    m_val2;
+    char        m_data[8192];
+};
+
 // Tests
 template< typename T >
 void testAlignment(std::unique_ptr< T >& freeList)
@@ -381,4 +477,1895 @@ TEST(FreeListTest, testMultithreadedDynamicMTMT)
 {
     auto freeList = std::make_shared< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(c_freeListSize);
     testMultithreaded(freeList);
-}
\ No newline at end of file
+}
+
+TEST(FreeListTest, testTaggedHeadAddressable)
+{
+    using Pool = fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode >;
+    using MTConstruct = fl::FreeListMTConstruct< TestNode, Pool >;
+    using STConstruct = fl::FreeListSTConstruct< TestNode, Pool >;
+
+    // Memory reaching past 48 bits, as under 5-level paging, would have its top bits overwritten by the tag
+    auto below = reinterpret_cast< const void* >(uint64_t(1) << 47);
+    auto above = reinterpret_cast< const void* >((uint64_t(1) << 48) + 64);
+    EXPECT_TRUE(MTConstruct::addressable(below));
+    EXPECT_FALSE(MTConstruct::addressable(above));
+    EXPECT_TRUE(STConstruct::addressable(above));
+
+    auto freeList = std::make_unique< Pool >(c_freeListSize);
+    EXPECT_TRUE(freeList->construct() != nullptr);
+}
+
+template< typename T >
+void testGrowth(std::unique_ptr< T >& freeList, const size_t maxSize)
+{
+    std::vector< typename T::ptr > nodes(maxSize);
+
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        auto node = freeList->construct(i, i + 1);
+        ASSERT_TRUE(node != nullptr);
+        nodes[i] = std::move(node);
+    }
+    ASSERT_FALSE(freeList->construct(0, 0));
+    ASSERT_EQ(freeList->capacity(), maxSize);
+
+    // Verify all nodes still good
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        EXPECT_EQ(nodes[i]->m_val1, i);
+        EXPECT_EQ(nodes[i]->m_val2, i + 1);
+    }
+
+    // Freed slots are reused without any further growth
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        nodes[i] = nullptr;
+    }
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(freeList->construct(0, 0));
+    ASSERT_EQ(freeList->capacity(), maxSize);
+}
+
+TEST(FreeListTest, testNoGrowthDynamic)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(100);
+    testGrowth(freeList, 100);
+}
+
+TEST(FreeListTest, testFixedGrowthDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(100, fl::FreeListGrowth::fixed(64, 1000));
+    testGrowth(freeList, 1000);
+}
+
+TEST(FreeListTest, testFixedGrowthDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(100, fl::FreeListGrowth::fixed(64, 1000));
+    testGrowth(freeList, 1000);
+}
+
+TEST(FreeListTest, testGeometricGrowthDynamicSTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerMultipleConsumer< TestNode > >(1, fl::FreeListGrowth::geometric(2, 100000));
+    testGrowth(freeList, 100000);
+}
+
+TEST(FreeListTest, testGeometricGrowthDynamicMTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerSingleConsumer< TestNode > >(1, fl::FreeListGrowth::geometric(3, 100000));
+    testGrowth(freeList, 100000);
+}
+
+TEST(FreeListTest, testMultithreadedGrowthDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(1000, fl::FreeListGrowth::geometric(2, c_freeListSize));
+    testMultithreaded(freeList);
+    ASSERT_LE(freeList->capacity(), c_freeListSize);
+}
+
+template< typename T >
+void testTrim(std::unique_ptr< T >& freeList, const size_t size, const size_t maxSize)
+{
+    std::vector< typename T::ptr > nodes(maxSize);
+
+    // Spike up to the growth limit, then free everything
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_EQ(freeList->capacity(), maxSize);
+
+    // A single live object pins its slab
+    auto pinned = std::move(nodes[maxSize - 1]);
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        nodes[i] = nullptr;
+    }
+
+    auto released = freeList->trim();
+    ASSERT_GT(released, 0U);
+    ASSERT_EQ(freeList->capacity(), maxSize - released);
+    ASSERT_GE(freeList->capacity(), size);
+    ASSERT_EQ(freeList->trim(), 0U);
+
+    // Trimmed slabs are recommitted on demand
+    pinned = nullptr;
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        nodes[i] = freeList->construct(i, i + 1);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(freeList->construct(0, 0));
+    ASSERT_EQ(freeList->capacity(), maxSize);
+
+    for (size_t i = 0 ; i < maxSize ; ++i) {
+        EXPECT_EQ(nodes[i]->m_val1, i);
+        EXPECT_EQ(nodes[i]->m_val2, i + 1);
+    }
+}
+
+TEST(FreeListTest, testTrimDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(1000, fl::FreeListGrowth::fixed(100000, 1000000), fl::FreeListBacking::transparentHugePages());
+    testTrim(freeList, 1000, 1000000);
+}
+
+TEST(FreeListTest, testTrimDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(1000, fl::FreeListGrowth::geometric(2, 1000000), fl::FreeListBacking::hugeTlb());
+    testTrim(freeList, 1000, 1000000);
+}
+
+TEST(FreeListTest, testNoTrimWithoutGrowth)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(1000);
+    ASSERT_EQ(freeList->trim(), 0U);
+    ASSERT_EQ(freeList->capacity(), 1000U);
+}
+
+TEST(FreeListTest, testNoTrimHeapBacking)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(10, fl::FreeListGrowth::fixed(10, 100));
+    std::vector< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode >::ptr > nodes;
+    for (size_t i = 0 ; i < 60 ; ++i) {
+        nodes.push_back(freeList->construct(i, i));
+    }
+    nodes.clear();
+
+    // Heap slabs can't have their pages dropped, so stay committed
+    ASSERT_EQ(freeList->trim(), 0U);
+    ASSERT_EQ(freeList->capacity(), 60U);
+}
+
+TEST(FreeListTest, testMultithreadedBackgroundTrimDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(1000, fl::FreeListGrowth::fixed(10000, c_freeListSize), fl::FreeListBacking::transparentHugePages());
+    fl::FreeListBackgroundTrim< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > trimmer(*freeList, std::chrono::milliseconds(1));
+
+    for (size_t run = 0 ; run < 3 ; ++run) {
+        testMultithreaded(freeList);
+    }
+    ASSERT_LE(freeList->capacity(), c_freeListSize);
+}
+
+TEST(FreeListTest, testMaxAllocationMagazineStaticMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListMagazine< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, c_freeListSize > > >();
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsMagazineDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(c_freeListSize);
+    testReallocations(freeList);
+}
+
+TEST(FreeListTest, testExceptionSafetyMagazine)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListMagazine< fl::FreeListStaticMultipleProducerMultipleConsumer< ExceptionNode, size >, 16 > >();
+    testExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testMagazineGrowthDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(100, fl::FreeListGrowth::fixed(64, 1000));
+    std::vector< decltype(freeList->construct(0, 0)) > nodes(1000);
+
+    for (size_t i = 0 ; i < 1000 ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(freeList->construct(0, 0));
+    ASSERT_EQ(freeList->pool().capacity(), 1000U);
+}
+
+TEST(FreeListTest, testMagazineFlushOnThreadExit)
+{
+    constexpr auto size = 1000;
+    using Pool = fl::FreeListMagazine< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, size >, 32 >;
+    auto freeList = std::make_shared< Pool >();
+
+    // Each thread leaves a part filled magazine behind, which must be returned to the pool when it exits
+    for (size_t run = 0 ; run < 4 ; ++run) {
+        std::async(std::launch::async, [freeList]() {
+            auto node = freeList->construct(1, 2);
+            ASSERT_TRUE(node != nullptr);
+        }).wait();
+    }
+
+    std::vector< Pool::ptr > nodes(size);
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(freeList->construct(0, 0));
+
+    // Explicitly flushed magazines are visible to other threads
+    nodes.clear();
+    freeList->flush();
+    std::async(std::launch::async, [freeList]() {
+        std::vector< Pool::ptr > nodes(size);
+        for (size_t i = 0 ; i < size ; ++i) {
+            nodes[i] = freeList->construct(i, i);
+            ASSERT_TRUE(nodes[i] != nullptr);
+        }
+    }).wait();
+}
+
+TEST(FreeListTest, testMagazineThreadOutlivesPool)
+{
+    using Pool = fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >;
+    std::promise< void > magazineFilled;
+    std::promise< void > poolDestroyed;
+    auto freeList = std::make_unique< Pool >(100);
+
+    auto fut = std::async(std::launch::async, [pool = freeList.get(), &magazineFilled, &poolDestroyed]() {
+        pool->construct(1, 2).reset();
+        magazineFilled.set_value();
+        // Exits with cached slots in a magazine whose pool has gone
+        poolDestroyed.get_future().wait();
+    });
+
+    magazineFilled.get_future().wait();
+    freeList = nullptr;
+    poolDestroyed.set_value();
+    fut.wait();
+}
+
+TEST(FreeListTest, testMultithreadedMagazineDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > > >(c_freeListSize);
+    testMultithreaded(freeList);
+}
+
+TEST(FreeListTest, testMaxAllocationSharded)
+{
+    // Stealing drains every shard before construct reports exhaustion
+    auto freeList = std::make_unique< fl::FreeListSharded< TestNode > >(c_freeListSize / 4, 4);
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsSharded)
+{
+    auto freeList = std::make_unique< fl::FreeListSharded< TestNode > >(c_freeListSize / 8, 8);
+    testReallocations(freeList);
+}
+
+TEST(FreeListTest, testExceptionSafetySharded)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListSharded< ExceptionNode > >(size / 2, 2);
+    testExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testGrowthSharded)
+{
+    auto freeList = std::make_unique< fl::FreeListSharded< TestNode > >(100, 3, fl::FreeListGrowth::fixed(100, 1000), fl::FreeListBacking::transparentHugePages());
+    // Growth only happens on the shard of the current CPU, once every shard is exhausted, so at least one
+    // shard can grow to its limit
+    std::vector< fl::FreeListSharded< TestNode >::ptr > nodes(1200);
+
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_GE(freeList->capacity(), nodes.size());
+
+    nodes.clear();
+    ASSERT_GT(freeList->trim(), 0U);
+}
+
+TEST(FreeListTest, testMultithreadedSharded)
+{
+    auto freeList = std::make_shared< fl::FreeListSharded< TestNode > >(c_freeListSize / 4, 4);
+    testMultithreaded(freeList);
+}
+
+template< typename T >
+void testConstructBatch(std::unique_ptr< T >& freeList, const size_t size)
+{
+    std::vector< typename T::ptr > nodes;
+    nodes.reserve(size);
+
+    // Batches are constructed in one go, and stop short once the list is exhausted
+    size_t batch = 7;
+    while (freeList->constructBatch(std::back_inserter(nodes), batch, 3U, 4U) == batch) {
+    }
+    ASSERT_EQ(nodes.size(), size);
+    ASSERT_FALSE(freeList->construct(0, 0));
+    ASSERT_EQ(freeList->constructBatch(std::back_inserter(nodes), batch, 0U, 0U), 0U);
+
+    for (auto& node : nodes) {
+        ASSERT_TRUE(node != nullptr);
+        EXPECT_EQ(node->m_val1, 3U);
+        EXPECT_EQ(node->m_val2, 4U);
+    }
+
+    nodes.clear();
+    ASSERT_EQ(freeList->constructBatch(std::back_inserter(nodes), size, 5U, 6U), size);
+    ASSERT_FALSE(freeList->construct(0, 0));
+}
+
+TEST(FreeListTest, testConstructBatchStaticSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 1000 > >();
+    testConstructBatch(freeList, 1000);
+}
+
+TEST(FreeListTest, testConstructBatchStaticMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, 1000 > >();
+    testConstructBatch(freeList, 1000);
+}
+
+TEST(FreeListTest, testConstructBatchGrowthDynamicMTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerSingleConsumer< TestNode > >(10, fl::FreeListGrowth::fixed(100, 1000));
+    testConstructBatch(freeList, 1000);
+}
+
+template< typename T >
+void testConstructBatchExceptionSafety(std::unique_ptr< T >& freeList, const size_t size)
+{
+    std::vector< typename T::ptr > nodes;
+
+    // The fifth constructor throws - the first four objects are kept and the remaining slots returned
+    size_t countdown = 4;
+    ASSERT_THROW(freeList->constructBatch(std::back_inserter(nodes), 10, std::ref(countdown)), std::runtime_error);
+    ASSERT_EQ(nodes.size(), 4U);
+
+    countdown = size;
+    ASSERT_EQ(freeList->constructBatch(std::back_inserter(nodes), size, std::ref(countdown)), size - 4);
+    ASSERT_FALSE(freeList->construct(std::ref(countdown)));
+}
+
+TEST(FreeListTest, testConstructBatchExceptionSafetyST)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< CountdownNode, size > >();
+    testConstructBatchExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testConstructBatchExceptionSafetyMT)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListStaticMultipleProducerMultipleConsumer< CountdownNode, size > >();
+    testConstructBatchExceptionSafety(freeList, size);
+}
+
+template< typename T >
+void batchAllocatorTestThread(std::shared_ptr< T > freeList)
+{
+    std::vector< typename T::ptr > nodes;
+
+    for (size_t run = 0 ; run < 100 ; ++run) {
+        while (freeList->constructBatch(std::back_inserter(nodes), 32, 1U, 2U) == 32 && nodes.size() < 10000) {
+        }
+        nodes.clear();
+    }
+}
+
+TEST(FreeListTest, testMultithreadedConstructBatchDynamicMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(20000);
+    std::vector< std::future< void > > fut(4);
+
+    for (auto& f : fut) {
+        f = std::async(std::launch::async, batchAllocatorTestThread< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >, freeList);
+    }
+    for (auto& f : fut) {
+        f.wait();
+    }
+
+    std::vector< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode >::ptr > nodes;
+    ASSERT_EQ(freeList->constructBatch(std::back_inserter(nodes), 20000, 1U, 2U), 20000U);
+}
+
+template< typename T >
+void testDestroyBatch(std::unique_ptr< T >& freeList, const size_t size)
+{
+    std::vector< typename T::ptr > nodes(size);
+
+    for (size_t run = 0 ; run < 3 ; ++run) {
+        for (size_t i = 0 ; i < size ; ++i) {
+            nodes[i] = freeList->construct(i, i + run);
+            ASSERT_TRUE(nodes[i] != nullptr);
+        }
+        ASSERT_FALSE(freeList->construct(0, 0));
+
+        // Null ptrs in the range are skipped
+        nodes[size / 2] = nullptr;
+        freeList->destroyBatch(nodes.begin(), nodes.end());
+
+        for (auto& node : nodes) {
+            ASSERT_TRUE(node == nullptr);
+        }
+    }
+}
+
+TEST(FreeListTest, testDestroyBatchStaticSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 1000 > >();
+    testDestroyBatch(freeList, 1000);
+}
+
+TEST(FreeListTest, testDestroyBatchDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(1000);
+    testDestroyBatch(freeList, 1000);
+}
+
+TEST(FreeListTest, testBatchDeleterAcrossPools)
+{
+    using Pool = fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode >;
+    constexpr size_t size = 1000;
+    Pool pool1(size);
+    Pool pool2(size);
+
+    for (size_t run = 0 ; run < 3 ; ++run) {
+        Pool::BatchDeleter< 16 > batch;
+
+        // Interleave the pools so each flush publishes several runs
+        for (size_t i = 0 ; i < size ; ++i) {
+            auto node1 = pool1.construct(i, i);
+            auto node2 = pool2.construct(i, i);
+            ASSERT_TRUE(node1 != nullptr);
+            ASSERT_TRUE(node2 != nullptr);
+            batch.add(std::move(node1));
+            if (i % 3) {
+                batch.add(std::move(node2));
+            }
+            else {
+                batch(node2.release());
+            }
+        }
+    }
+
+    std::vector< Pool::ptr > nodes(size);
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = pool1.construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(pool1.construct(0, 0));
+}
+
+template< typename T >
+void testSlabLayout(std::unique_ptr< T >& freeList, const size_t size)
+{
+    using Node = typename T::value_type;
+    std::vector< typename T::ptr > nodes(size);
+
+    // Without a header, slots are packed at sizeof(Node) apart within a slab
+    static_assert(T::c_slotSize == sizeof(Node), "Slot must be the size of the object");
+
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(i, false);
+        ASSERT_TRUE(nodes[i] != nullptr);
+        ASSERT_EQ(reinterpret_cast< uintptr_t >(nodes[i].get()) % alignof(Node), 0U);
+        ASSERT_EQ(T::owner(nodes[i].get()), freeList.get());
+
+        if (i % T::c_slotsPerSlab) {
+            ASSERT_EQ(reinterpret_cast< uintptr_t >(nodes[i].get()), reinterpret_cast< uintptr_t >(nodes[i - 1].get()) + sizeof(Node));
+        }
+    }
+    ASSERT_FALSE(freeList->construct(0, false));
+}
+
+TEST(FreeListTest, testSlabLayout)
+{
+    using Pool = fl::FreeListSlabSingleProducerSingleConsumer< AlignmentNode >;
+    auto freeList = std::make_unique< Pool >(Pool::c_slotsPerSlab * 10);
+    testSlabLayout(freeList, Pool::c_slotsPerSlab * 10);
+}
+
+TEST(FreeListTest, testSlabLayoutSmallSlabs)
+{
+    using Pool = fl::FreeListSlab< AlignmentNode, fl::FreeListMTConstruct, fl::FreeListMTDestroy, 4096 >;
+    auto freeList = std::make_unique< Pool >(10000);
+    testSlabLayout(freeList, 10000);
+}
+
+TEST(FreeListTest, testMaxAllocationSlabSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabSingleProducerSingleConsumer< TestNode > >(c_freeListSize);
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsSlabMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabMultipleProducerMultipleConsumer< TestNode > >(c_freeListSize);
+    testReallocations(freeList);
+}
+
+TEST(FreeListTest, testExceptionSafetySlabMTST)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListSlabMultipleProducerSingleConsumer< ExceptionNode > >(size);
+    testExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testGrowthSlabSTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabSingleProducerMultipleConsumer< TestNode > >(10, fl::FreeListGrowth::geometric(2, 100000));
+    testGrowth(freeList, 100000);
+}
+
+TEST(FreeListTest, testMultithreadedSlabMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListSlabMultipleProducerMultipleConsumer< TestNode > >(c_freeListSize);
+    testMultithreaded(freeList);
+}
+
+TEST(FreeListTest, testIndexWidthStaticIndexed)
+{
+    static_assert(std::is_same< fl::FreeListStaticIndexedSingleProducerSingleConsumer< uint16_t, 65534 >::Index, uint16_t >::value, "Expected 16-bit links");
+    static_assert(std::is_same< fl::FreeListStaticIndexedSingleProducerSingleConsumer< uint16_t, 65535 >::Index, uint32_t >::value, "Expected 32-bit links");
+    static_assert(fl::FreeListStaticIndexedSingleProducerSingleConsumer< uint16_t, 1000 >::c_slotSize == sizeof(uint16_t), "Expected no per-slot overhead");
+    static_assert(fl::FreeListStaticIndexedSingleProducerSingleConsumer< TestNode, 1000 >::c_slotSize == sizeof(TestNode), "Expected no per-slot overhead");
+}
+
+TEST(FreeListTest, testTinyNodesStaticIndexedSTMT)
+{
+    constexpr size_t size = 60000;
+    auto freeList = std::make_unique< fl::FreeListStaticIndexedSingleProducerMultipleConsumer< uint16_t, size > >();
+
+    std::vector< decltype(freeList)::element_type::ptr > nodes(size);
+
+    for (size_t i = 0 ; i < size ; ++i) {
+        auto node = freeList->construct(static_cast< uint16_t >(i));
+        ASSERT_TRUE(node != nullptr);
+
+        // Slots are packed back to back
+        if (i) {
+            ASSERT_EQ(reinterpret_cast< unsigned long >(node.get()), reinterpret_cast< unsigned long >(nodes[i - 1].get()) + sizeof(uint16_t));
+        }
+
+        nodes[i] = std::move(node);
+    }
+    ASSERT_FALSE(freeList->construct(0));
+
+    for (size_t i = 0 ; i < size ; ++i) {
+        EXPECT_EQ(*nodes[i], i);
+        nodes[i] = nullptr;
+    }
+
+    // Freed slots can be reused, including the sentinel the list ended on
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(static_cast< uint16_t >(i));
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    ASSERT_FALSE(freeList->construct(0));
+}
+
+TEST(FreeListTest, testMaxAllocationStaticIndexedSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticIndexedSingleProducerSingleConsumer< TestNode, c_freeListSize > >();
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsStaticIndexedMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticIndexedMultipleProducerMultipleConsumer< TestNode, c_freeListSize > >();
+    testReallocations(freeList);
+}
+
+TEST(FreeListTest, testExceptionSafetyStaticIndexedMTST)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListStaticIndexedMultipleProducerSingleConsumer< ExceptionNode, size > >();
+    testExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testMultithreadedStaticIndexedMTMT)
+{
+    auto freeList = std::make_shared< fl::FreeListStaticIndexedMultipleProducerMultipleConsumer< TestNode, c_freeListSize > >();
+    testMultithreaded(freeList);
+}
+
+TEST(FreeListTest, testNothrowConstructionPropagates)
+{
+    static_assert(std::is_nothrow_constructible< fl::FreeListAlloc< uint64_t >, void*, unsigned >::value, "Expected nothrow slot construction");
+    static_assert(!std::is_nothrow_constructible< fl::FreeListAlloc< ExceptionNode >, void*, unsigned, bool >::value, "Expected throwing slot construction");
+}
+
+template< typename T >
+void testForwarding(std::unique_ptr< T >& freeList)
+{
+    CopyCounter counter;
+
+    auto lvalueNode = freeList->construct(counter);
+    ASSERT_TRUE(lvalueNode != nullptr);
+    EXPECT_EQ(lvalueNode->m_copies, 0U);
+
+    auto rvalueNode = freeList->construct(CopyCounter());
+    ASSERT_TRUE(rvalueNode != nullptr);
+    EXPECT_EQ(rvalueNode->m_copies, 0U);
+}
+
+TEST(FreeListTest, testForwardingStaticMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticMultipleProducerMultipleConsumer< ForwardNode, 10 > >();
+    testForwarding(freeList);
+}
+
+TEST(FreeListTest, testForwardingDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< ForwardNode > >(10);
+    testForwarding(freeList);
+}
+
+TEST(FreeListTest, testForwardingMagazineDynamicMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListMagazine< fl::FreeListDynamicMultipleProducerMultipleConsumer< ForwardNode > > >(10);
+    testForwarding(freeList);
+}
+
+TEST(FreeListTest, testForwardingSlabSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListSlabSingleProducerSingleConsumer< ForwardNode > >(10);
+    testForwarding(freeList);
+}
+
+TEST(FreeListTest, testForwardingStaticIndexedSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticIndexedSingleProducerSingleConsumer< ForwardNode, 10 > >();
+    testForwarding(freeList);
+}
+
+template< typename T >
+void testDestructors(std::unique_ptr< T >& freeList, const size_t size)
+{
+    size_t destroyed = 0;
+    std::vector< typename T::ptr > nodes(size);
+
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(destroyed);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+
+    for (size_t i = 0 ; i < size / 2 ; ++i) {
+        nodes[i] = nullptr;
+    }
+    EXPECT_EQ(destroyed, size / 2);
+
+    freeList->destroyBatch(nodes.begin() + size / 2, nodes.end());
+    EXPECT_EQ(destroyed, size);
+}
+
+TEST(FreeListTest, testDestructorsStaticSTMT)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerMultipleConsumer< DestructorNode, size > >();
+    testDestructors(freeList, size);
+}
+
+TEST(FreeListTest, testDestructorsSlabMTMT)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListSlabMultipleProducerMultipleConsumer< DestructorNode > >(size);
+    testDestructors(freeList, size);
+}
+
+TEST(FreeListTest, testMaxAllocationDynamicTransparentHugePagesMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(c_freeListSize, fl::FreeListGrowth::none(), fl::FreeListBacking::transparentHugePages());
+    ASSERT_EQ(freeList->backing(), fl::FreeListBacking::Mode::TransparentHugePages);
+
+    // The first slot starts the slab, which sits on a huge page boundary
+    auto first = freeList->construct(0U, 0U);
+    auto slab = reinterpret_cast< uintptr_t >(fl::FreeListAlloc< TestNode >::fromData(first.get()));
+    ASSERT_EQ(slab % fl::FreeListBacking::c_hugePageSize, 0U);
+    first = nullptr;
+
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsDynamicHugeTlbSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(c_freeListSize, fl::FreeListGrowth::none(), fl::FreeListBacking::hugeTlb());
+
+    // Without reserved hugetlbfs pages, quietly falls back to transparent huge pages
+    ASSERT_NE(freeList->backing(), fl::FreeListBacking::Mode::Heap);
+    testReallocations(freeList);
+}
+
+TEST(FreeListTest, testTrimDynamicTransparentHugePagesMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(1000, fl::FreeListGrowth::geometric(2, 1000000), fl::FreeListBacking::transparentHugePages());
+    testTrim(freeList, 1000, 1000000);
+}
+
+// Fake CPU lookup, so each test thread can claim to run on any CPU of a fake topology
+thread_local int t_fakeCpu = 0;
+
+int fakeCpu()
+{
+    return t_fakeCpu;
+}
+
+fl::FreeListNumaTopology fakeTopology()
+{
+    return fl::FreeListNumaTopology({ { 0, 1 }, { 2, 3 } }, fakeCpu);
+}
+
+TEST(FreeListTest, testNumaTopology)
+{
+    auto topology = fakeTopology();
+    ASSERT_EQ(topology.nodes(), 2U);
+
+    t_fakeCpu = 3;
+    EXPECT_EQ(topology.currentNode(), 1U);
+    t_fakeCpu = 1;
+    EXPECT_EQ(topology.currentNode(), 0U);
+    // Unknown CPUs fall back to the first node
+    t_fakeCpu = 99;
+    EXPECT_EQ(topology.currentNode(), 0U);
+    t_fakeCpu = 0;
+
+    auto system = fl::FreeListNumaTopology::system();
+    ASSERT_GE(system.nodes(), 1U);
+}
+
+TEST(FreeListTest, testMaxAllocationNuma)
+{
+    auto freeList = std::make_unique< fl::FreeListNuma< TestNode > >(c_freeListSize / 2, fakeTopology());
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testExceptionSafetyNuma)
+{
+    constexpr auto size = 100;
+    auto freeList = std::make_unique< fl::FreeListNuma< ExceptionNode > >(size / 2, fakeTopology());
+    testExceptionSafety(freeList, size);
+}
+
+TEST(FreeListTest, testNumaLocalConstruct)
+{
+    constexpr size_t size = 100;
+    fl::FreeListNuma< TestNode > freeList(size, fakeTopology());
+    std::vector< fl::FreeListNuma< TestNode >::ptr > nodes(size + 1);
+
+    // Everything comes from the local node until it's exhausted, and only then from the remote one
+    t_fakeCpu = 2;
+    for (size_t i = 0 ; i < size + 1 ; ++i) {
+        nodes[i] = freeList.construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+        EXPECT_EQ(freeList.nodeOf(nodes[i].get()), i < size ? 1U : 0U);
+    }
+    t_fakeCpu = 0;
+}
+
+TEST(FreeListTest, testNumaRemoteFreeRouting)
+{
+    constexpr size_t size = 100;
+    fl::FreeListNuma< TestNode > freeList(size, fakeTopology());
+    std::vector< fl::FreeListNuma< TestNode >::ptr > nodes(size);
+
+    t_fakeCpu = 2;
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList.construct(i, i);
+    }
+
+    // Free every node 1 object from a thread on node 0
+    std::async(std::launch::async, [&nodes]() {
+        t_fakeCpu = 0;
+        for (auto& node : nodes) {
+            node = nullptr;
+        }
+    }).wait();
+
+    // The slots went back to node 1, so node 1 can reuse all of them without touching node 0
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList.construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+        EXPECT_EQ(freeList.nodeOf(nodes[i].get()), 1U);
+    }
+    t_fakeCpu = 0;
+}
+
+TEST(FreeListTest, testNumaGrowsLocalFirst)
+{
+    constexpr size_t size = 100;
+    fl::FreeListNuma< TestNode > freeList(size, fakeTopology(), fl::FreeListGrowth::fixed(size, size * 2));
+    std::vector< fl::FreeListNuma< TestNode >::ptr > nodes(size * 3);
+
+    for (size_t i = 0 ; i < size * 3 ; ++i) {
+        nodes[i] = freeList.construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+        EXPECT_EQ(freeList.nodeOf(nodes[i].get()), i < size * 2 ? 0U : 1U);
+    }
+    EXPECT_EQ(freeList.node(0).capacity(), size * 2);
+    EXPECT_EQ(freeList.node(1).capacity(), size);
+}
+
+// Each shard's slots are resident once it's built, before any are constructed into
+TEST(FreeListTest, testNumaPrefaultsShards)
+{
+    constexpr size_t size = 4;
+    fl::FreeListNuma< PageNode > freeList(size, fakeTopology());
+    const auto pageSize = static_cast< uintptr_t >(sysconf(_SC_PAGESIZE));
+
+    for (size_t node = 0 ; node < freeList.nodes() ; ++node) {
+        auto obj = freeList.node(node).construct(0U, 0U);
+        ASSERT_TRUE(obj != nullptr);
+
+        auto lastSlot = reinterpret_cast< uintptr_t >(obj.get()) + sizeof(fl::FreeListAlloc< PageNode >) * (size - 1);
+        unsigned char resident = 0;
+        ASSERT_EQ(mincore(reinterpret_cast< void* >(lastSlot & ~(pageSize - 1)), pageSize, &resident), 0);
+        EXPECT_TRUE(resident & 1);
+    }
+}
+
+// Where the kernel reports page placement, each node's slots are on that node
+TEST(FreeListTest, testNumaPagePlacement)
+{
+    fl::FreeListNuma< PageNode > freeList(4);
+    for (size_t node = 0 ; node < freeList.nodes() ; ++node) {
+        auto obj = freeList.node(node).construct(0U, 0U);
+        ASSERT_TRUE(obj != nullptr);
+
+        void* page = obj.get();
+        int status = -1;
+        if (syscall(SYS_move_pages, 0, 1, &page, nullptr, &status, 0) != 0) {
+            GTEST_SKIP() << "move_pages unavailable";
+        }
+        EXPECT_EQ(status, static_cast< int >(node));
+    }
+}
+
+TEST(FreeListTest, testMultithreadedNuma)
+{
+    auto freeList = std::make_shared< fl::FreeListNuma< TestNode > >(c_freeListSize);
+    testMultithreaded(freeList);
+}
+
+// Minor page faults taken by this thread so far
+size_t minorFaults()
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return static_cast< size_t >(usage.ru_minflt);
+}
+
+// Construct every slot, returning the page faults taken while doing so
+template< typename T >
+size_t constructFaults(std::unique_ptr< T >& freeList, const size_t size)
+{
+    std::vector< typename T::ptr > nodes(size);
+
+    // Run the construct path once first, so faulting in its code isn't counted
+    freeList->construct(0U, 0U);
+
+    auto before = minorFaults();
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+    }
+    auto faults = minorFaults() - before;
+
+    for (size_t i = 0 ; i < size ; ++i) {
+        EXPECT_TRUE(nodes[i] != nullptr);
+        EXPECT_EQ(nodes[i]->m_val1, i);
+    }
+    return faults;
+}
+
+TEST(FreeListTest, testFaultsWithoutPrefaultDynamic)
+{
+    constexpr size_t size = 1000;
+    // Freshly mapped, rather than heap pages earlier tests may already have faulted in
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< PageNode > >(size, fl::FreeListGrowth::none(), fl::FreeListBacking::transparentHugePages());
+
+    // Slots are handed out by the bump pointer, so nothing but the sentinel is touched until each is constructed
+    EXPECT_GT(constructFaults(freeList, size), 0U);
+}
+
+TEST(FreeListTest, testPrefaultDynamicSTST)
+{
+    constexpr size_t size = 1000;
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< PageNode > >(size, fl::FreeListGrowth::none(), fl::FreeListBacking::heap().withPrefault());
+    EXPECT_EQ(constructFaults(freeList, size), 0U);
+}
+
+TEST(FreeListTest, testLockDynamicMTMT)
+{
+    constexpr size_t size = 100;
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< PageNode > >(size, fl::FreeListGrowth::fixed(size, size * 2), fl::FreeListBacking::transparentHugePages().withLock());
+    EXPECT_EQ(constructFaults(freeList, size), 0U);
+
+    // Locked pools keep their pages resident
+    EXPECT_EQ(freeList->trim(), 0U);
+}
+
+TEST(FreeListTest, testLockFailureReported)
+{
+    rlimit limit;
+    getrlimit(RLIMIT_MEMLOCK, &limit);
+    auto restricted = limit;
+    restricted.rlim_cur = 0;
+    setrlimit(RLIMIT_MEMLOCK, &restricted);
+
+    auto threw = false;
+    try {
+        fl::FreeListDynamicSingleProducerSingleConsumer< PageNode > freeList(100, fl::FreeListGrowth::none(), fl::FreeListBacking::heap().withLock());
+    }
+    catch (const std::system_error&) {
+        threw = true;
+    }
+    setrlimit(RLIMIT_MEMLOCK, &limit);
+
+    if (!threw) {
+        GTEST_SKIP() << "Locked memory limit isn't enforced for this process";
+    }
+}
+
+TEST(FreeListTest, testLazyInitialisationDynamicSTST)
+{
+    constexpr size_t size = 10000;
+
+    // Only the sentinel is touched up front, so no page of the slot array is committed by construction
+    auto before = minorFaults();
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< PageNode > >(size);
+    EXPECT_LT(minorFaults() - before, 16U);
+
+    // Every slot is still handed out, once, by the bump pointer
+    EXPECT_GT(constructFaults(freeList, size), 0U);
+}
+
+TEST(FreeListTest, testLazyInitialisationReuseMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, 10 > >();
+
+    // Never-used slots are handed out in order
+    auto first = freeList->construct(1U, 1U);
+    auto second = freeList->construct(2U, 2U);
+    auto stride = reinterpret_cast< uintptr_t >(second.get()) - reinterpret_cast< uintptr_t >(first.get());
+    ASSERT_EQ(stride, sizeof(fl::FreeListAlloc< TestNode >));
+
+    // A destroyed slot is appended behind the sentinel, the last slot, which can then be handed out. The destroyed
+    // slot becomes the new sentinel, and the bump range carries on
+    first = nullptr;
+    auto third = freeList->construct(3U, 3U);
+    EXPECT_EQ(reinterpret_cast< uintptr_t >(third.get()), reinterpret_cast< uintptr_t >(second.get()) + stride * 9);
+    auto fourth = freeList->construct(4U, 4U);
+    EXPECT_EQ(reinterpret_cast< uintptr_t >(fourth.get()), reinterpret_cast< uintptr_t >(second.get()) + stride);
+
+    // A further destroy lets the first slot be reused
+    auto firstSlot = reinterpret_cast< uintptr_t >(second.get()) - stride;
+    second = nullptr;
+    auto fifth = freeList->construct(5U, 5U);
+    EXPECT_EQ(reinterpret_cast< uintptr_t >(fifth.get()), firstSlot);
+}
+
+TEST(FreeListTest, testMaxAllocationDynamicEagerSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(
+            c_freeListSize, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), fl::FreeListInit::eager());
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testMaxAllocationDynamicEagerParallelMTMT)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(
+            c_freeListSize, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), fl::FreeListInit::eager(4));
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testEagerParallelInitialisationOrderDynamicSTST)
+{
+    constexpr size_t size = 1000000;
+
+    // Ranges linked on separate threads run straight into each other, so slots come out in array order
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(
+            size, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), fl::FreeListInit::eager(3));
+    std::vector< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode >::ptr > nodes(size);
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+        if (i > 0) {
+            ASSERT_EQ(reinterpret_cast< uintptr_t >(nodes[i].get()) - reinterpret_cast< uintptr_t >(nodes[i - 1].get()),
+                      sizeof(fl::FreeListAlloc< TestNode >));
+        }
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+}
+
+TEST(FreeListTest, testEagerParallelGrowthDynamicMTMT)
+{
+    constexpr size_t size = 100000;
+
+    // Growth slabs are linked with the same threads
+    auto freeList = std::make_unique< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >(
+            size, fl::FreeListGrowth::geometric(2, size * 4), fl::FreeListBacking::heap(), fl::FreeListInit::eager(4));
+    std::vector< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode >::ptr > nodes(size * 4);
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+        ASSERT_TRUE(nodes[i] != nullptr);
+    }
+    EXPECT_GE(freeList->capacity(), size * 4);
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        EXPECT_EQ(nodes[i]->m_val1, i);
+    }
+}
+
+TEST(FreeListTest, testCacheLineIsolationStaticSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 10 > >();
+    static_assert(alignof(fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 10 >) >= fl::c_cacheLineSize);
+
+    // The slot array starts on its own line, after the head and tail, which have a line each
+    auto first = freeList->construct(1U, 1U);
+    auto slot = reinterpret_cast< uintptr_t >(first.get()) - offsetof(fl::FreeListAlloc< TestNode >, m_data);
+    EXPECT_EQ(slot % fl::c_cacheLineSize, 0U);
+    EXPECT_GE(slot - reinterpret_cast< uintptr_t >(freeList.get()), 2 * fl::c_cacheLineSize);
+}
+
+TEST(FreeListTest, testMaxAllocationStaticLIFOSingleThreaded)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticLIFOSingleThreaded< TestNode, c_freeListSize > >();
+    testMaxAllocations(freeList);
+}
+
+TEST(FreeListTest, testReallocationsDynamicLIFOMultiThreaded)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicLIFOMultiThreaded< TestNode > >(c_freeListSize);
+    testReallocations(freeList);
+}
+
+template< typename T >
+void testReuseOrder(std::unique_ptr< T >& freeList, const fl::FreeListReuse reuse)
+{
+    std::vector< typename T::ptr > nodes(4);
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+    }
+    std::vector< TestNode* > freed = { nodes[1].get(), nodes[2].get() };
+    nodes[1] = nullptr;
+    nodes[2] = nullptr;
+
+    // LIFO hands the slot freed last straight back, FIFO only after every other free slot
+    auto first = freeList->construct(5U, 5U);
+    auto second = freeList->construct(6U, 6U);
+    if (reuse == fl::FreeListReuse::Lifo) {
+        EXPECT_EQ(first.get(), freed[1]);
+        EXPECT_EQ(second.get(), freed[0]);
+    }
+    else {
+        EXPECT_NE(first.get(), freed[1]);
+        EXPECT_NE(first.get(), freed[0]);
+    }
+}
+
+TEST(FreeListTest, testReuseOrderStaticLIFOSingleThreaded)
+{
+    auto freeList = std::make_unique< fl::FreeListStaticLIFOSingleThreaded< TestNode, 100 > >();
+    static_assert(fl::FreeListStaticLIFOSingleThreaded< TestNode, 100 >::c_reuse == fl::FreeListReuse::Lifo);
+    testReuseOrder(freeList, fl::FreeListReuse::Lifo);
+}
+
+TEST(FreeListTest, testReuseOrderDynamicLIFOMultiThreaded)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicLIFOMultiThreaded< TestNode > >(
+            100, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), fl::FreeListInit::eager());
+    testReuseOrder(freeList, fl::FreeListReuse::Lifo);
+}
+
+TEST(FreeListTest, testReuseOrderDynamicSTST)
+{
+    auto freeList = std::make_unique< fl::FreeListDynamicSingleProducerSingleConsumer< TestNode > >(
+            100, fl::FreeListGrowth::none(), fl::FreeListBacking::heap(), fl::FreeListInit::eager());
+    static_assert(fl::FreeListDynamicSingleProducerSingleConsumer< TestNode >::c_reuse == fl::FreeListReuse::Fifo);
+    testReuseOrder(freeList, fl::FreeListReuse::Fifo);
+}
+
+TEST(FreeListTest, testMultithreadedStaticLIFOMultiThreaded)
+{
+    auto freeList = std::make_shared< fl::FreeListStaticLIFOMultiThreaded< TestNode, c_freeListSize > >();
+    static_assert(fl::FreeListStaticLIFOMultiThreaded< TestNode, c_freeListSize >::c_multiThreadedDestroy);
+    static_assert(!fl::FreeListStaticLIFOSingleThreaded< TestNode, c_freeListSize >::c_multiThreadedDestroy);
+    testMultithreaded(freeList);
+}
+
+TEST(FreeListTest, testGrowthAndTrimDynamicLIFOMultiThreaded)
+{
+    auto growing = std::make_unique< fl::FreeListDynamicLIFOMultiThreaded< TestNode > >(100, fl::FreeListGrowth::fixed(64, 1000));
+    testGrowth(growing, 1000);
+
+    auto trimming = std::make_unique< fl::FreeListDynamicLIFOMultiThreaded< TestNode > >(1000, fl::FreeListGrowth::geometric(2, 1000000), fl::FreeListBacking::transparentHugePages());
+    testTrim(trimming, 1000, 1000000);
+}
+
+TEST(FreeListTest, testMultithreadedMagazineDynamicLIFOMultiThreaded)
+{
+    auto freeList = std::make_shared< fl::FreeListMagazine< fl::FreeListDynamicLIFOMultiThreaded< TestNode > > >(c_freeListSize);
+    testMultithreaded(freeList);
+}
+
+TEST(FreeListTest, testStatsStaticSTST)
+{
+    using FreeList = fl::FreeListStatic< TestNode, 10, fl::FreeListSTConstruct, fl::FreeListSTDestroy, fl::FreeListStats >;
+    auto freeList = std::make_unique< FreeList >();
+
+    std::vector< FreeList::ptr > nodes(10);
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+    for (size_t i = 0 ; i < 4 ; ++i) {
+        nodes[i] = nullptr;
+    }
+
+    auto snapshot = freeList->stats().snapshot();
+    EXPECT_EQ(snapshot.m_constructs, 10U);
+    EXPECT_EQ(snapshot.m_destroys, 4U);
+    EXPECT_EQ(snapshot.m_failures, 1U);
+    EXPECT_EQ(snapshot.m_casRetries, 0U);
+    EXPECT_EQ(snapshot.m_live, 6U);
+    EXPECT_EQ(snapshot.m_highWatermark, 10U);
+}
+
+TEST(FreeListTest, testStatsBatchesDynamicMTMT)
+{
+    using FreeList = fl::FreeListDynamic< TestNode, fl::FreeListMTConstruct, fl::FreeListMTDestroy, fl::FreeListStats >;
+    auto freeList = std::make_unique< FreeList >(100, fl::FreeListGrowth::fixed(100, 300));
+
+    // Growth isn't a failure, only coming up short once the pool can't grow any further
+    std::vector< FreeList::ptr > nodes;
+    EXPECT_EQ(freeList->constructBatch(std::back_inserter(nodes), 250, 1U, 2U), 250U);
+    EXPECT_EQ(freeList->stats().snapshot().m_failures, 0U);
+    EXPECT_EQ(freeList->constructBatch(std::back_inserter(nodes), 100, 1U, 2U), 50U);
+
+    freeList->destroyBatch(nodes.begin(), nodes.begin() + 100);
+    {
+        FreeList::BatchDeleter< 16 > batch;
+        for (size_t i = 100 ; i < 150 ; ++i) {
+            batch.add(std::move(nodes[i]));
+        }
+    }
+
+    auto snapshot = freeList->stats().snapshot();
+    EXPECT_EQ(snapshot.m_constructs, 300U);
+    EXPECT_EQ(snapshot.m_destroys, 150U);
+    EXPECT_EQ(snapshot.m_failures, 1U);
+    EXPECT_EQ(snapshot.m_live, 150U);
+    EXPECT_EQ(snapshot.m_highWatermark, 300U);
+}
+
+TEST(FreeListTest, testMultithreadedStatsDynamicMTMT)
+{
+    using FreeList = fl::FreeListDynamic< TestNode, fl::FreeListMTConstruct, fl::FreeListMTDestroy, fl::FreeListStats >;
+    auto freeList = std::make_shared< FreeList >(c_freeListSize);
+    testMultithreaded(freeList);
+
+    auto snapshot = freeList->stats().snapshot();
+    EXPECT_GT(snapshot.m_constructs, 0U);
+    EXPECT_EQ(snapshot.m_constructs, snapshot.m_destroys);
+    EXPECT_EQ(snapshot.m_live, 0U);
+    EXPECT_GT(snapshot.m_highWatermark, 0U);
+    EXPECT_LE(snapshot.m_highWatermark, c_freeListSize);
+}
+
+TEST(FreeListTest, testStatsMagazineDynamicMTMT)
+{
+    using FreeList = fl::FreeListMagazine< fl::FreeListDynamic< TestNode, fl::FreeListMTConstruct, fl::FreeListMTDestroy,
+                                                                fl::FreeListStats > >;
+    auto freeList = std::make_unique< FreeList >(100);
+
+    // Slots cached in the magazine are counted as they're constructed and destroyed, not as they move in bulk
+    std::vector< FreeList::ptr > nodes(100);
+    for (size_t i = 0 ; i < nodes.size() ; ++i) {
+        nodes[i] = freeList->construct(i, i);
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+    for (size_t i = 0 ; i < 40 ; ++i) {
+        nodes[i] = nullptr;
+    }
+    {
+        FreeList::BatchDeleter< 16 > batch;
+        for (size_t i = 40 ; i < 50 ; ++i) {
+            batch.add(std::move(nodes[i]));
+        }
+    }
+
+    auto snapshot = freeList->stats().snapshot();
+    EXPECT_EQ(snapshot.m_constructs, 100U);
+    EXPECT_EQ(snapshot.m_destroys, 50U);
+    EXPECT_EQ(snapshot.m_failures, 1U);
+    EXPECT_EQ(snapshot.m_live, 50U);
+    EXPECT_EQ(snapshot.m_highWatermark, 100U);
+    EXPECT_EQ(freeList->pool().stats().snapshot().m_constructs, 100U);
+}
+
+TEST(FreeListTest, testStatsDisabledByDefault)
+{
+    static_assert(!fl::FreeListKeepsStats< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >::value);
+    static_assert(fl::FreeListKeepsStats< fl::FreeListStatic< TestNode, 10, fl::FreeListMTConstruct, fl::FreeListMTDestroy,
+                                                              fl::FreeListStats > >::value);
+
+    auto freeList = std::make_unique< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 10 > >();
+    auto node = freeList->construct(1U, 1U);
+    EXPECT_EQ(freeList->stats().snapshot().m_constructs, 0U);
+}
+
+TEST(FreeListTest, testConstructWaitBlocking)
+{
+    using FreeList = fl::FreeListBlocking< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, 2 > >;
+    auto freeList = std::make_unique< FreeList >();
+
+    auto first = freeList->constructWait(1U, 1U);
+    auto second = freeList->constructWait(2U, 2U);
+    ASSERT_FALSE(freeList->construct(0U, 0U));
+
+    // The waiter parks until the slot held by first is freed
+    auto waiter = std::async(std::launch::async, [&freeList]() {
+        return freeList->constructWait(3U, 3U);
+    });
+    while (freeList->waiters() == 0) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(waiter.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+    first = nullptr;
+    auto third = waiter.get();
+    ASSERT_TRUE(third != nullptr);
+    EXPECT_EQ(third->m_val1, 3U);
+    EXPECT_EQ(freeList->waiters(), 0U);
+}
+
+// A batch returns its slots as one chain, which wakes every parked thread rather than one
+TEST(FreeListTest, testBatchReleaseWakesAllBlocking)
+{
+    using FreeList = fl::FreeListBlocking< fl::FreeListStaticMultipleProducerMultipleConsumer< TestNode, 2 > >;
+    auto freeList = std::make_unique< FreeList >();
+
+    auto first = freeList->constructWait(1U, 1U);
+    auto second = freeList->constructWait(2U, 2U);
+
+    std::vector< std::future< FreeList::ptr > > waiters;
+    for (unsigned i = 0 ; i < 2 ; ++i) {
+        waiters.push_back(std::async(std::launch::async, [&freeList, i]() {
+            return freeList->constructWait(i, i);
+        }));
+    }
+    while (freeList->waiters() != 2) {
+        std::this_thread::yield();
+    }
+
+    {
+        FreeList::BatchDeleter<> batch;
+        batch.add(std::move(first));
+        batch.add(std::move(second));
+    }
+    for (auto& waiter : waiters) {
+        EXPECT_TRUE(waiter.get() != nullptr);
+    }
+    EXPECT_EQ(freeList->waiters(), 0U);
+}
+
+TEST(FreeListTest, testConstructForTimeout)
+{
+    using FreeList = fl::FreeListBlocking< fl::FreeListDynamicMultipleProducerMultipleConsumer< MoveNode > >;
+    auto freeList = std::make_unique< FreeList >(1);
+    auto held = freeList->constructWait(std::make_unique< unsigned >(1U));
+
+    // A timed out construct returns nullptr, and leaves its arguments untouched
+    auto start = std::chrono::steady_clock::now();
+    auto arg = std::make_unique< unsigned >(2U);
+    EXPECT_FALSE(freeList->constructFor(std::chrono::milliseconds(20), std::move(arg)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_TRUE(arg != nullptr);
+    EXPECT_EQ(freeList->waiters(), 0U);
+
+    // And succeeds once a slot is freed within the timeout
+    auto releaser = std::async(std::launch::async, [&held]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        held = nullptr;
+    });
+    auto node = freeList->constructFor(std::chrono::seconds(10), std::move(arg));
+    ASSERT_TRUE(node != nullptr);
+    EXPECT_EQ(*node->m_val, 2U);
+    releaser.wait();
+}
+
+// Many more producers than slots, each holding its object briefly, so most constructs have to wait
+TEST(FreeListTest, testMultithreadedConstructWaitBackpressure)
+{
+    using FreeList = fl::FreeListBlocking< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >;
+    constexpr size_t numThreads = 8;
+    constexpr size_t iterations = 2000;
+    auto freeList = std::make_shared< FreeList >(2);
+
+    std::vector< std::future< void > > fut(numThreads);
+    for (size_t t = 0 ; t < numThreads ; ++t) {
+        fut[t] = std::async(std::launch::async, [freeList, t]() {
+            for (size_t i = 0 ; i < iterations ; ++i) {
+                auto node = freeList->constructWait(t, i);
+                ASSERT_TRUE(node != nullptr);
+                EXPECT_EQ(node->m_val1, t);
+                EXPECT_EQ(node->m_val2, i);
+                if (i % 16 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& f : fut) {
+        f.wait();
+    }
+    EXPECT_EQ(freeList->waiters(), 0U);
+}
+
+// Whether fd is readable, without waiting
+static bool readable(const int fd)
+{
+    pollfd pfd{ fd, POLLIN, 0 };
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+TEST(FreeListTest, testEventFdNotifiesOnExhaustionTransition)
+{
+    using FreeList = fl::FreeListEventFd< fl::FreeListStaticSingleProducerSingleConsumer< TestNode, 2 > >;
+    auto freeList = std::make_unique< FreeList >();
+
+    // Destroys that don't follow an exhaustion don't notify
+    auto first = freeList->construct(1U, 1U);
+    first = nullptr;
+    EXPECT_FALSE(readable(freeList->fd()));
+
+    first = freeList->construct(1U, 1U);
+    auto second = freeList->construct(2U, 2U);
+    ASSERT_FALSE(freeList->construct(0U, 0U));
+    EXPECT_FALSE(readable(freeList->fd()));
+
+    first = nullptr;
+    EXPECT_TRUE(readable(freeList->fd()));
+
+    // Only the transition notifies
+    freeList->clear();
+    EXPECT_FALSE(readable(freeList->fd()));
+    second = nullptr;
+    EXPECT_FALSE(readable(freeList->fd()));
+
+    auto third = freeList->construct(3U, 3U);
+    ASSERT_TRUE(third != nullptr);
+    EXPECT_EQ(third->m_val1, 3U);
+}
+
+TEST(FreeListTest, testEventFdWatermark)
+{
+    using FreeList = fl::FreeListEventFd< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >;
+    auto freeList = std::make_unique< FreeList >(3);
+    freeList->setWatermark(2);
+
+    std::vector< FreeList::ptr > nodes;
+    for (unsigned i = 0 ; i < 3 ; ++i) {
+        nodes.push_back(freeList->construct(i, i));
+    }
+    ASSERT_FALSE(freeList->construct(0U, 0U));
+
+    nodes.pop_back();
+    EXPECT_FALSE(readable(freeList->fd()));
+    nodes.pop_back();
+    EXPECT_TRUE(readable(freeList->fd()));
+}
+
+TEST(FreeListTest, testEventFdBatchReleaseNotifies)
+{
+    using FreeList = fl::FreeListEventFd< fl::FreeListDynamicMultipleProducerMultipleConsumer< TestNode > >;
+    auto freeList = std::make_unique< FreeList >(4);
+    freeList->setWatermark(4);
+
+    std::vector< FreeList::ptr > nodes;
+    for (unsigned i = 0 ; i < 4 ; ++i) {
+        nodes.push_back(freeList->construct(i, i));
+    }
+    ASSERT_FALSE(freeList->construct(0U, 0U));
+
+    // A batch's length isn't known to the pool, so any released chain notifies
+    {
+        FreeList::BatchDeleter<> batch;
+        batch.add(std::move(nodes.back()));
+    }
+    EXPECT_TRUE(readable(freeList->fd()));
+}
+
+// A path in the temporary directory, unique to this process, removed on destruction
+struct TempPath
+{
+    explicit TempPath(const std::string& name)
+        : m_path("/tmp/freelist_" + name + "_" + std::to_string(getpid()))
+    {
+        unlink(m_path.c_str());
+    }
+
+    ~TempPath()
+    {
+        unlink(m_path.c_str());
+    }
+
+    std::string m_path;
+};
+
+TEST(FreeListTest, testPersistentReattach)
+{
+    using FreeList = fl::FreeListPersistentMultipleProducerMultipleConsumer< TestNode >;
+    TempPath path("persistent_reattach");
+
+    {
+        auto freeList = std::make_unique< FreeList >(path.m_path, 8);
+        EXPECT_EQ(freeList->capacity(), 8U);
+        for (unsigned i = 0 ; i < 4 ; ++i) {
+            auto node = freeList->construct(i, i * 10);
+            ASSERT_TRUE(node != nullptr);
+            // Released rather than reset, so the object outlives the pool
+            if (i != 2) {
+                node.release();
+            }
+        }
+    }
+
+    // The size is taken from the file when reattaching
+    auto freeList = std::make_unique< FreeList >(path.m_path, 1);
+    EXPECT_EQ(freeList->capacity(), 8U);
+
+    std::vector< FreeList::ptr > live;
+    freeList->forEach([&freeList, &live](TestNode& node) {
+        live.push_back(freeList->adopt(&node));
+    });
+    ASSERT_EQ(live.size(), 3U);
+    unsigned sum = 0;
+    for (auto& node : live) {
+        EXPECT_EQ(node->m_val2, node->m_val1 * 10);
+        sum += node->m_val1;
+    }
+    EXPECT_EQ(sum, 0U + 1U + 3U);
+
+    // Every slot is usable again once the adopted objects are destroyed
+    live.clear();
+    std::vector< FreeList::ptr > nodes;
+    for (unsigned i = 0 ; i < 8 ; ++i) {
+        nodes.push_back(freeList->construct(i, i));
+        ASSERT_TRUE(nodes.back() != nullptr);
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+}
+
+TEST(FreeListTest, testPersistentRepairsTornDestroy)
+{
+    using FreeList = fl::FreeListPersistentMultipleProducerMultipleConsumer< TestNode >;
+    constexpr size_t size = 4;
+    TempPath path("persistent_torn");
+
+    {
+        auto freeList = std::make_unique< FreeList >(path.m_path, size);
+        auto torn = freeList->construct(1U, 1U);
+        auto kept = freeList->construct(2U, 2U);
+        kept.release();
+
+        // Unlink the destroyed slot from the old tail, the sentinel, as a crash between publishing the new tail and
+        // linking it in would leave it
+        torn = nullptr;
+        freeList->node(static_cast< FreeList::Index >(size)).setNext(FreeList::c_null);
+    }
+
+    auto freeList = std::make_unique< FreeList >(path.m_path, size);
+
+    // The torn slot is leaked, and reported as live
+    std::vector< TestNode* > live;
+    freeList->forEach([&live](TestNode& node) {
+        live.push_back(&node);
+    });
+    ASSERT_EQ(live.size(), 2U);
+
+    // Destroys append to the list the head reaches, so the freed slot can be constructed again
+    for (auto node : live) {
+        if (node->m_val1 == 2U) {
+            freeList->adopt(node);
+        }
+    }
+    std::vector< FreeList::ptr > nodes;
+    while (auto node = freeList->construct(0U, 0U)) {
+        nodes.push_back(std::move(node));
+    }
+    EXPECT_EQ(nodes.size(), size - 1);
+}
+
+TEST(FreeListTest, testPersistentRefusesIncompatibleFile)
+{
+    TempPath path("persistent_incompatible");
+
+    {
+        fl::FreeListPersistentSingleProducerSingleConsumer< TestNode > freeList(path.m_path, 4);
+
+        // The file is locked while attached
+        EXPECT_THROW(fl::FreeListPersistentSingleProducerSingleConsumer< TestNode >(path.m_path, 4), std::system_error);
+    }
+
+    struct WideNode
+    {
+        uint64_t    m_vals[4];
+    };
+    EXPECT_THROW(fl::FreeListPersistentSingleProducerSingleConsumer< WideNode >(path.m_path, 4), std::runtime_error);
+    EXPECT_THROW(fl::FreeListPersistentMultipleProducerMultipleConsumer< TestNode >(path.m_path, 4), std::runtime_error);
+    EXPECT_NO_THROW(fl::FreeListPersistentSingleProducerSingleConsumer< TestNode >(path.m_path, 4));
+}
+
+// Exit status of a forked child, or -1 if it didn't exit normally
+static int waitForChild(const pid_t pid)
+{
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+TEST(FreeListTest, testSharedPassesObjectsBetweenProcesses)
+{
+    using FreeList = fl::FreeListSharedMultipleProducerMultipleConsumer< TestNode >;
+    auto fd = memfd_create("freelist_shared", MFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    auto freeList = std::make_unique< FreeList >(fd, 16);
+
+    auto sent = freeList->construct(7U, 70U);
+    auto sentIndex = freeList->index(sent.get());
+    sent.release();
+
+    int pipeFds[2];
+    ASSERT_EQ(pipe(pipeFds), 0);
+
+    auto pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        // A second mapping of the pool, at another address, takes the object by index and sends one back
+        FreeList child(fd);
+        auto received = child.adopt(child.object(sentIndex));
+        auto ok = received->m_val1 == 7U && received->m_val2 == 70U;
+        received = nullptr;
+
+        auto reply = child.construct(8U, 80U);
+        auto replyIndex = child.index(reply.get());
+        reply.release();
+        ok = ok && write(pipeFds[1], &replyIndex, sizeof(replyIndex)) == sizeof(replyIndex);
+        _exit(ok ? 0 : 1);
+    }
+
+    ASSERT_EQ(waitForChild(pid), 0);
+    FreeList::Index replyIndex = 0;
+    ASSERT_EQ(read(pipeFds[0], &replyIndex, sizeof(replyIndex)), static_cast< ssize_t >(sizeof(replyIndex)));
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+
+    auto reply = freeList->adopt(freeList->object(replyIndex));
+    EXPECT_EQ(reply->m_val1, 8U);
+    EXPECT_EQ(reply->m_val2, 80U);
+    reply = nullptr;
+
+    // Every slot is free again
+    std::vector< FreeList::ptr > nodes;
+    for (unsigned i = 0 ; i < 16 ; ++i) {
+        nodes.push_back(freeList->construct(i, i));
+        ASSERT_TRUE(nodes.back() != nullptr);
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+
+    nodes.clear();
+    freeList = nullptr;
+    close(fd);
+}
+
+// Both processes construct and destroy through the same lock free list at once
+TEST(FreeListTest, testMultiprocessSharedMTMT)
+{
+    using FreeList = fl::FreeListSharedMultipleProducerMultipleConsumer< TestNode >;
+    constexpr size_t size = 64;
+    constexpr size_t iterations = 200000;
+    auto fd = memfd_create("freelist_shared", MFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    auto freeList = std::make_unique< FreeList >(fd, size);
+
+    // Hold up to 8 objects at a time, checking each is untouched by the other process before destroying it
+    auto run = [](FreeList& pool, const unsigned tag) {
+        std::vector< FreeList::ptr > held;
+        size_t failures = 0;
+        for (size_t i = 0 ; i < iterations ; ++i) {
+            if (auto node = pool.construct(tag, static_cast< unsigned >(i))) {
+                held.push_back(std::move(node));
+            }
+            if (held.size() == 8 || i % 3 == 0) {
+                for (auto& node : held) {
+                    failures += node->m_val1 != tag;
+                }
+                held.clear();
+            }
+        }
+        return failures;
+    };
+
+    auto pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        FreeList child(fd);
+        _exit(run(child, 2U) == 0 ? 0 : 1);
+    }
+
+    EXPECT_EQ(run(*freeList, 1U), 0U);
+    ASSERT_EQ(waitForChild(pid), 0);
+
+    std::vector< FreeList::ptr > nodes;
+    for (size_t i = 0 ; i < size ; ++i) {
+        nodes.push_back(freeList->construct(0U, 0U));
+        ASSERT_TRUE(nodes.back() != nullptr);
+    }
+    EXPECT_FALSE(freeList->construct(0U, 0U));
+
+    nodes.clear();
+    freeList = nullptr;
+    close(fd);
+}
+
+TEST(FreeListTest, testSharedRefusesIncompatiblePool)
+{
+    auto fd = memfd_create("freelist_shared", MFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+
+    // Nothing has been created yet
+    EXPECT_THROW(fl::FreeListSharedMultipleProducerMultipleConsumer< TestNode >{ fd }, std::runtime_error);
+
+    fl::FreeListSharedMultipleProducerMultipleConsumer< TestNode > freeList(fd, 4);
+    EXPECT_THROW(fl::FreeListSharedSingleProducerSingleConsumer< TestNode >{ fd }, std::runtime_error);
+    EXPECT_NO_THROW(fl::FreeListSharedMultipleProducerMultipleConsumer< TestNode >{ fd });
+    close(fd);
+}
+
+TEST(FreeListTest, testRawBlocks)
+{
+    auto freeList = std::make_unique< fl::FreeListRawSingleProducerSingleConsumer >(20, 16, 4, fl::FreeListGrowth::fixed(2, 6));
+    EXPECT_EQ(freeList->blockSize(), 32U);
+    EXPECT_EQ(freeList->blockAlign(), 16U);
+
+    // Blocks are aligned and don't overlap, and growth stops at its limit
+    std::vector< char* > blocks;
+    while (auto block = static_cast< char* >(freeList->allocate())) {
+        EXPECT_EQ(reinterpret_cast< uintptr_t >(block) % 16, 0U);
+        std::memset(block, static_cast< int >(blocks.size()), 20);
+        blocks.push_back(block);
+    }
+    ASSERT_EQ(blocks.size(), 6U);
+    EXPECT_EQ(freeList->capacity(), 6U);
+    for (size_t i = 0 ; i < blocks.size() ; ++i) {
+        EXPECT_EQ(blocks[i][0], static_cast< char >(i));
+        EXPECT_EQ(blocks[i][19], static_cast< char >(i));
+    }
+
+    // A freed block becomes the sentinel, so the next allocate takes the previous one
+    freeList->deallocate(blocks.back());
+    EXPECT_TRUE(freeList->allocate() != nullptr);
+    EXPECT_EQ(freeList->allocate(), nullptr);
+}
+
+TEST(FreeListTest, testSizeClassRouting)
+{
+    using SizeClasses = fl::FreeListSizeClassesSingleProducerSingleConsumer;
+    EXPECT_EQ(SizeClasses::classOf(1, 1), 0U);
+    EXPECT_EQ(SizeClasses::classOf(8, 8), 0U);
+    EXPECT_EQ(SizeClasses::classOf(9, 8), 1U);
+    EXPECT_EQ(SizeClasses::classOf(24, 8), 2U);
+    EXPECT_EQ(SizeClasses::classOf(8, 64), 3U);
+    EXPECT_EQ(SizeClasses::classOf(4096, 8), SizeClasses::c_classes - 1);
+    EXPECT_EQ(SizeClasses::classOf(4097, 8), SizeClasses::c_classes);
+    EXPECT_FALSE(SizeClasses::fits(8, 8192));
+
+    auto sizeClasses = std::make_unique< SizeClasses >(4096);
+    EXPECT_EQ(sizeClasses->allocate(5000), nullptr);
+
+    for (size_t bytes = 1 ; bytes <= SizeClasses::c_maxBlockSize ; bytes = bytes * 3 / 2 + 1) {
+        for (size_t alignment = 1 ; alignment <= 256 ; alignment *= 4) {
+            auto p = sizeClasses->allocate(bytes, alignment);
+            ASSERT_TRUE(p != nullptr);
+            EXPECT_EQ(reinterpret_cast< uintptr_t >(p) % alignment, 0U);
+            std::memset(p, 0xff, bytes);
+            sizeClasses->deallocate(p, bytes, alignment);
+        }
+    }
+}
+
+TEST(FreeListTest, testMultithreadedSizeClassesMTMT)
+{
+    constexpr size_t numThreads = 8;
+    constexpr size_t iterations = 20000;
+    auto sizeClasses = std::make_shared< fl::FreeListSizeClassesMultipleProducerMultipleConsumer >(16 * 1024);
+
+    std::vector< std::future< size_t > > fut(numThreads);
+    for (size_t t = 0 ; t < numThreads ; ++t) {
+        fut[t] = std::async(std::launch::async, [sizeClasses, t]() {
+            size_t failures = 0;
+            std::vector< std::pair< unsigned char*, size_t > > held;
+            for (size_t i = 0 ; i < iterations ; ++i) {
+                auto bytes = (i * 37 + t * 11) % 600 + 1;
+                auto p = static_cast< unsigned char* >(sizeClasses->allocate(bytes));
+                std::memset(p, static_cast< int >(t), bytes);
+                held.emplace_back(p, bytes);
+
+                if (held.size() == 16) {
+                    for (auto& block : held) {
+                        failures += block.first[0] != t || block.first[block.second - 1] != t;
+                        sizeClasses->deallocate(block.first, block.second);
+                    }
+                    held.clear();
+                }
+            }
+            for (auto& block : held) {
+                sizeClasses->deallocate(block.first, block.second);
+            }
+            return failures;
+        });
+    }
+    for (auto& f : fut) {
+        EXPECT_EQ(f.get(), 0U);
+    }
+}
+
+// Counts the requests forwarded to it, serving them from the default resource
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t  m_allocations = 0;
+    size_t  m_deallocations = 0;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++m_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        ++m_deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST(FreeListTest, testMemoryResourceContainers)
+{
+    CountingResource upstream;
+    fl::FreeListMemoryResourceSingleProducerSingleConsumer resource(&upstream);
+
+    {
+        std::pmr::list< TestNode > list(&resource);
+        std::pmr::map< unsigned, TestNode > map(&resource);
+        std::pmr::unordered_map< unsigned, TestNode > unorderedMap(&resource);
+        for (unsigned i = 0 ; i < 200 ; ++i) {
+            list.emplace_back(i, i);
+            map.emplace(i, TestNode(i, i * 2));
+            unorderedMap.emplace(i, TestNode(i, i * 3));
+        }
+        for (unsigned i = 0 ; i < 200 ; i += 2) {
+            map.erase(i);
+            unorderedMap.erase(i);
+        }
+        list.remove_if([](const TestNode& node) { return node.m_val1 % 2 == 0; });
+
+        EXPECT_EQ(list.size(), 100U);
+        EXPECT_EQ(map.size(), 100U);
+        EXPECT_EQ(unorderedMap.size(), 100U);
+        for (unsigned i = 1 ; i < 200 ; i += 2) {
+            EXPECT_EQ(map.at(i).m_val2, i * 2);
+            EXPECT_EQ(unorderedMap.at(i).m_val2, i * 3);
+        }
+        EXPECT_EQ(upstream.m_allocations, 0U);
+
+        // Too large for any size class
+        std::pmr::vector< char > large(8192, 0, &resource);
+        EXPECT_EQ(upstream.m_allocations, 1U);
+    }
+    EXPECT_EQ(upstream.m_deallocations, 1U);
+}
+
+TEST(FreeListTest, testMemoryResourceExhaustionThrows)
+{
+    // 8 blocks of 8 bytes, with no room to grow
+    fl::FreeListMemoryResourceSingleProducerSingleConsumer resource(std::pmr::get_default_resource(), 64, 64);
+
+    std::vector< void* > blocks;
+    for (size_t i = 0 ; i < 8 ; ++i) {
+        blocks.push_back(resource.allocate(8, 8));
+    }
+    EXPECT_THROW(static_cast< void >(resource.allocate(8, 8)), std::bad_alloc);
+
+    // Other classes are unaffected
+    auto other = resource.allocate(16, 8);
+    resource.deallocate(other, 16, 8);
+    for (auto block : blocks) {
+        resource.deallocate(block, 8, 8);
+    }
+    EXPECT_TRUE(resource.is_equal(resource));
+}
+
+TEST(FreeListTest, testAllocatorContainers)
+{
+    using SizeClasses = fl::FreeListSizeClassesSingleProducerSingleConsumer;
+    SizeClasses sizeClasses;
+
+    std::list< TestNode, fl::FreeListAllocator< TestNode, SizeClasses > > list{ fl::FreeListAllocator< TestNode, SizeClasses >(sizeClasses) };
+    using MapAllocator = fl::FreeListAllocator< std::pair< const unsigned, TestNode >, SizeClasses >;
+    std::map< unsigned, TestNode, std::less< unsigned >, MapAllocator > map{ MapAllocator(sizeClasses) };
+    std::unordered_map< unsigned, TestNode, std::hash< unsigned >, std::equal_to< unsigned >, MapAllocator > unorderedMap{ MapAllocator(sizeClasses) };
+
+    for (unsigned i = 0 ; i < 1000 ; ++i) {
+        list.emplace_back(i, i);
+        map.emplace(i, TestNode(i, i * 2));
+        unorderedMap.emplace(i, TestNode(i, i * 3));
+    }
+    for (unsigned i = 0 ; i < 1000 ; i += 2) {
+        map.erase(i);
+        unorderedMap.erase(i);
+    }
+
+    EXPECT_EQ(list.size(), 1000U);
+    EXPECT_EQ(map.size(), 500U);
+    EXPECT_EQ(unorderedMap.size(), 500U);
+    for (unsigned i = 1 ; i < 1000 ; i += 2) {
+        EXPECT_EQ(map.at(i).m_val2, i * 2);
+        EXPECT_EQ(unorderedMap.at(i).m_val2, i * 3);
+    }
+
+    // Rebound copies share the size classes
+    fl::FreeListAllocator< TestNode, SizeClasses > allocator(sizeClasses);
+    fl::FreeListAllocator< double, SizeClasses > rebound(allocator);
+    EXPECT_TRUE(rebound == allocator);
+    SizeClasses otherSizeClasses;
+    fl::FreeListAllocator< TestNode, SizeClasses > other(otherSizeClasses);
+    EXPECT_TRUE(allocator != other);
+}
+
+TEST(FreeListTest, testAllocatorRoutesArraysElsewhere)
+{
+    using SizeClasses = fl::FreeListSizeClassesSingleProducerSingleConsumer;
+    // A single slab of 64 bytes per class, with no room to grow
+    SizeClasses sizeClasses(64, 64);
+    fl::FreeListAllocator< uint64_t, SizeClasses > allocator(sizeClasses);
+
+    // Single objects come from the 8 byte class until it's exhausted
+    std::vector< uint64_t* > objects;
+    for (size_t i = 0 ; i < 8 ; ++i) {
+        objects.push_back(allocator.allocate(1));
+    }
+    EXPECT_THROW(static_cast< void >(allocator.allocate(1)), std::bad_alloc);
+
+    // Arrays don't touch the pools
+    auto array = allocator.allocate(1000);
+    std::fill(array, array + 1000, 1U);
+    allocator.deallocate(array, 1000);
+
+    for (auto object : objects) {
+        allocator.deallocate(object, 1);
+    }
+    objects.push_back(allocator.allocate(1));
+    allocator.deallocate(objects.back(), 1);
+}